@@ -79,6 +79,8 @@ int main(){
             triggerAudio = false;
         }
 
+        audioEngine->Update(); // Hand voices to playing sources, finished sources return theirs
+
         renderer->EndFrame(); // End frame, poll events
     }
     /* ------------------------------------------------------ */
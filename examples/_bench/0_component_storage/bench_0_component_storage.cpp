@@ -0,0 +1,125 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/* GLEP - Benchmark 0: Component Storage */
+
+// Compares per-object components (unique_ptr, virtual Update per object) with
+// contiguous per-type ComponentPool storage, using the pool's static Update and systems.
+// Each is timed as a bare loop and through Scene::UpdateObjects, which also runs
+// SceneObject::Update, the transform pass and the BVH refit.
+// Usage: GLEPBench_0_component_storage [objects] [frames]
+
+#include <GLEP/core.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace GLEP;
+
+struct Counter : public ObjectComponent{
+    float Value = 0.0f;
+    void Update() override { Value += 1.0f; }
+    json ToJson() override { return json(); }
+};
+
+struct Drift : public ObjectComponent{
+    glm::vec3 Offset = glm::vec3(0.0f);
+    void Update() override { Offset += glm::vec3(0.1f); }
+    json ToJson() override { return json(); }
+};
+
+struct Decay : public ObjectComponent{
+    float Value = 0.0f;
+    void Update() override { Value = Value * 0.5f + 1.0f; }
+    json ToJson() override { return json(); }
+};
+
+template <typename F>
+double msPerFrame(int frames, F update){
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < frames; i++) update();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+}
+
+//Spread objects out, the scene's BVH degenerates if every object shares one point
+glm::vec3 gridPosition(int index){
+    return glm::vec3(index % 316, 0.0f, index / 316);
+}
+
+int main(int argc, char** argv){
+    int objectCount = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 100;
+
+    /* -Per-object components- */
+    Scene objectScene;
+    for(int i = 0; i < objectCount; i++){
+        std::shared_ptr<SceneObject> object = std::make_shared<SceneObject>();
+        object->Position = gridPosition(i);
+        object->Add(std::make_unique<Counter>());
+        object->Add(std::make_unique<Drift>());
+        object->Add(std::make_unique<Decay>());
+        objectScene.Add(object);
+    }
+
+    /* -Contiguous per-type storage- */
+    Scene storedScene;
+    ComponentStore& store = storedScene.GetComponentStore();
+    for(int i = 0; i < objectCount; i++){
+        std::shared_ptr<SceneObject> object = std::make_shared<SceneObject>();
+        object->Position = gridPosition(i);
+        storedScene.Add(object);
+        object->AddStoredComponent<Counter>();
+        object->AddStoredComponent<Drift>();
+        object->AddStoredComponent<Decay>();
+    }
+
+    //Start every component and settle transforms before timing
+    objectScene.UpdateObjects();
+    storedScene.UpdateObjects();
+
+    double perObject = msPerFrame(frames, [&](){
+        for(std::shared_ptr<SceneObject>& object : objectScene.GetObjects()){
+            for(std::unique_ptr<ObjectComponent>& component : object->GetComponents()) component->Update();
+        }
+    });
+    double perObjectScene = msPerFrame(frames, [&](){ objectScene.UpdateObjects(); });
+
+    double pooled = msPerFrame(frames, [&](){ store.Update(); });
+
+    store.SetSystem<Counter>([](ComponentPool<Counter>& pool){
+        for(Counter& c : pool.GetComponents()) c.Value += 1.0f;
+    });
+    store.SetSystem<Drift>([](ComponentPool<Drift>& pool){
+        for(Drift& d : pool.GetComponents()) d.Offset += glm::vec3(0.1f);
+    });
+    store.SetSystem<Decay>([](ComponentPool<Decay>& pool){
+        for(Decay& d : pool.GetComponents()) d.Value = d.Value * 0.5f + 1.0f;
+    });
+    double system = msPerFrame(frames, [&](){ store.Update(); });
+    double systemScene = msPerFrame(frames, [&](){ storedScene.UpdateObjects(); });
+
+    std::printf("%d objects x 3 components, %d frames\n", objectCount, frames);
+    std::printf("  per-object virtual Update:           %.3f ms/frame\n", perObject);
+    std::printf("  per-object, Scene::UpdateObjects:    %.3f ms/frame\n", perObjectScene);
+    std::printf("  ComponentPool Update:                %.3f ms/frame (%.1fx)\n", pooled, perObject / pooled);
+    std::printf("  ComponentPool with systems:          %.3f ms/frame (%.1fx)\n", system, perObject / system);
+    std::printf("  systems, Scene::UpdateObjects:       %.3f ms/frame (%.1fx vs per-object scene)\n", systemScene, perObjectScene / systemScene);
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/* GLEP - Benchmark 1: Blur Radius */
+
+// Times the post-processing graph at 1080p and 4K with a plain copy, a 3x3 kernel,
+// the separable BlurPass over a range of radii, and BloomPass at several mip levels.
+// Times are GPU-synchronised milliseconds per frame, including the final copy.
+// Usage: GLEPBench_1_blur_radius [iterations]
+
+#include <GLEP/core.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace GLEP;
+
+struct BenchGraph{
+    RenderGraph Graph;
+    std::shared_ptr<Framebuffer> Scene;
+    std::shared_ptr<Framebuffer> Output;
+    std::shared_ptr<BufferPassComposer> Composer;
+};
+
+void buildGraph(BenchGraph& bench, glm::vec2 resolution, std::shared_ptr<BufferPass> pass){
+    bench.Scene = std::make_shared<Framebuffer>(resolution);
+    bench.Output = std::make_shared<Framebuffer>(resolution);
+    bench.Composer = std::make_shared<BufferPassComposer>(resolution);
+    if(pass) bench.Composer->Add(pass);
+
+    bench.Graph.Clear();
+    RenderGraphResource objects = bench.Graph.ImportTarget("objects", bench.Scene);
+    RenderGraphResource output = bench.Graph.ImportTarget("output", bench.Output);
+    bench.Composer->AddPasses(bench.Graph, objects, objects, output);
+    bench.Graph.Compile();
+}
+
+double msPerFrame(glm::vec2 resolution, std::shared_ptr<BufferPass> pass, int iterations){
+    BenchGraph bench;
+    buildGraph(bench, resolution, pass);
+
+    bench.Scene->Bind();
+    glClearColor(0.5f, 0.3f, 0.2f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    //First execute allocates the transient targets
+    bench.Graph.Execute();
+    glFinish();
+
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < iterations; i++){
+        bench.Graph.Execute();
+        glFinish();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int main(int argc, char** argv){
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 10;
+
+    //The renderer initializes the window and its GL context, the graphs below are built and executed directly
+    std::shared_ptr<Window> window = std::make_shared<Window>(WindowState::WINDOWED, glm::vec2(320, 180), "GLEPBench - Blur Radius");
+    std::unique_ptr<Renderer> renderer = std::make_unique<Renderer>(window);
+    std::printf("%s, %s\n", (const char*)glGetString(GL_VERSION), (const char*)glGetString(GL_RENDERER));
+
+    const glm::vec2 resolutions[2] = { glm::vec2(1920, 1080), glm::vec2(3840, 2160) };
+    const float radii[6] = { 2.0f, 4.0f, 8.0f, 16.0f, 32.0f, 62.0f };
+    const int bloomLevels[3] = { 4, 6, 8 };
+
+    for(glm::vec2 resolution : resolutions){
+        std::printf("\n%dx%d\n", (int)resolution.x, (int)resolution.y);
+        std::printf("  copy only            %8.2f ms\n", msPerFrame(resolution, nullptr, iterations));
+        std::printf("  kernel 3x3           %8.2f ms\n", msPerFrame(resolution, std::make_shared<KernelPass>(KernelPass::BLUR, 1.0f / resolution.x), iterations));
+
+        for(float radius : radii)
+            std::printf("  blur r=%-3d           %8.2f ms\n", (int)radius, msPerFrame(resolution, std::make_shared<BlurPass>(radius), iterations));
+
+        for(int levels : bloomLevels)
+            std::printf("  bloom %d levels       %8.2f ms\n", levels, msPerFrame(resolution, std::make_shared<BloomPass>(0.8f, 1.0f, levels), iterations));
+    }
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/* GLEP - Benchmark 2: Parallel Load */
+
+// Loads one generated scene of models with Scene::LoadThreads set to 1, 2, 4, 8 and
+// the hardware thread count. Objects are built on the load threads and their GL work
+// is replayed on the main thread, so every load must serialize to the same JSON.
+// Usage: GLEPBench_2_parallel_load [models] [runs]
+
+#include <GLEP/core.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using namespace GLEP;
+
+//Spread models out, the scene's BVH degenerates if every object shares one point
+glm::vec3 gridPosition(int index){
+    return glm::vec3(index % 64, 0.0f, index / 64) * 2.0f;
+}
+
+int main(int argc, char** argv){
+    int modelCount = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    //The renderer initializes the window and its GL context, scenes are loaded without rendering
+    std::shared_ptr<Window> window = std::make_shared<Window>(WindowState::WINDOWED, glm::vec2(320, 180), "GLEPBench - Parallel Load");
+    std::unique_ptr<Renderer> renderer = std::make_unique<Renderer>(window);
+
+    json data;
+    {
+        Scene source;
+        for(int i = 0; i < modelCount; i++){
+            std::shared_ptr<Geometry> geometry = std::make_shared<CubeGeometry>(1.0f, 1.0f, 1.0f, 16, 16, 16);
+            std::shared_ptr<Model> model = std::make_shared<Model>(geometry, std::make_shared<LambertMaterial>(Color(1.0f, 0.5f, 0.2f)));
+            model->Position = gridPosition(i);
+            source.Add(model);
+        }
+        data = source.ToJson();
+    }
+
+    const unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned int threadCounts[5] = { 1, 2, 4, 8, hardwareThreads };
+
+    std::printf("%d models, %d runs, %u hardware threads\n", modelCount, runs, hardwareThreads);
+
+    //Untimed sequential load, warms up the driver and gives the JSON every load is checked against
+    Scene::LoadThreads = 1;
+    json reference = Scene::FromJson(data)->ToJson();
+
+    bool identical = true;
+    double sequentialMs = 0.0;
+    for(int i = 0; i < 5; i++){
+        unsigned int threads = threadCounts[i];
+        Scene::LoadThreads = threads;
+
+        double totalMs = 0.0;
+        for(int r = 0; r < runs; r++){
+            auto start = std::chrono::steady_clock::now();
+            std::shared_ptr<Scene> scene = Scene::FromJson(data);
+            glFinish();
+            totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            if(scene->ToJson() != reference){
+                std::printf("  %u threads: loaded scene differs from the sequential load\n", threads);
+                identical = false;
+            }
+        }
+
+        double ms = totalMs / runs;
+        if(i == 0) sequentialMs = ms;
+        std::printf("  %2u threads%s  %8.2f ms/load (%.1fx)\n", threads, i == 4 ? " (hw):" : ":     ", ms, sequentialMs / ms);
+    }
+
+    return identical ? 0 : 1;
+}
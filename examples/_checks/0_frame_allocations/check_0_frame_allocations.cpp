@@ -0,0 +1,120 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/* GLEP - Check 0: Frame Allocations */
+
+// Renders a static scene with shadows, several lights and post-processing, with and without
+// the depth pre-pass, and exits non-zero if any frame after warm-up allocates on the heap.
+// Requires the library to be built with GLEP_TRACK_ALLOCATIONS set to ON.
+// Usage: GLEPCheck_0_frame_allocations [frames]
+
+#include <GLEP/core.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace GLEP;
+
+const glm::vec2 screenResolution = glm::vec2(800, 600);
+
+const int WARM_UP_FRAMES = 5;
+
+int main(int argc, char** argv){
+    if(!AllocationTracker::IsEnabled()){
+        Print(PrintCode::ERROR, "CHECK", "Allocation tracking is disabled, build with GLEP_TRACK_ALLOCATIONS set to ON.");
+        return 1;
+    }
+
+    int frames = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    /* -Initialise key objects (Window, Camera & Renderer)- */
+    std::shared_ptr<Window> window = std::make_shared<Window>(WindowState::WINDOWED, screenResolution, "GLEPCheck - Frame Allocations");
+
+    std::shared_ptr<PerspectiveCamera> camera = std::make_shared<PerspectiveCamera>(45.0f, screenResolution.x / screenResolution.y, 0.01f, 100.0f);
+    camera->Position = glm::vec3(0.0f, 2.0f, 10.0f);
+    camera->Rotation = glm::quat(glm::lookAt(camera->Position, glm::vec3(0.0f), Camera::UP));
+
+    std::unique_ptr<Renderer> renderer = std::make_unique<Renderer>(window, camera);
+    /* ------------------------------------------------------ */
+
+    /* -Static scene- */
+    std::shared_ptr<Scene> scene = std::make_shared<Scene>();
+
+    std::shared_ptr<Geometry> cubeGeometry = std::make_shared<CubeGeometry>(1.0f, 1.0f, 1.0f);
+    std::shared_ptr<Material> materials[] = {
+        std::make_shared<PhongMaterial>(Color::WHITE, 32.0f),
+        std::make_shared<LambertMaterial>(Color::RED),
+        std::make_shared<UnlitMaterial>(Color::BLUE),
+        std::make_shared<PhongMaterial>(std::make_shared<Texture>(File::GLEP_DEFUALT_TEXTURE), 32.0f)
+    };
+    materials[0]->CastShadows = true;
+    materials[0]->ReceiveShadows = true;
+    materials[1]->CastShadows = true;
+
+    for(int i = 0; i < 200; i++){
+        std::shared_ptr<Model> cube = std::make_shared<Model>(cubeGeometry, materials[i % 4]);
+        cube->Position = glm::vec3((i % 20) - 10, 0, (i / 20) - 5);
+        cube->IsStatic = i % 2 == 0;
+        scene->Add(cube);
+    }
+
+    scene->Add(std::make_shared<AmbientLight>(Color::WHITE, 0.4f));
+    scene->Add(std::make_shared<DirectionalLight>(glm::vec3(-0.2f, -1.0f, -0.3f), Color::WHITE, 0.2f));
+    for(int i = 0; i < 4; i++)
+        scene->Add(std::make_shared<PointLight>(glm::vec3(i, 1, 0), Color::BLUE, 1.0f, 1.0f, 0.09f, 0.032f));
+    for(int i = 0; i < 2; i++)
+        scene->Add(std::make_shared<SpotLight>(glm::vec3(i, 1, 2), glm::vec3(0.0f, 0.5f, 1.0f), Color::RED, 2.0f, 15.0f, 10.0f, 1.0f, 0.09f, 0.032f));
+
+    const float kernel[9] = {1, 2, 1, 2, 4, 2, 1, 2, 1};
+    std::shared_ptr<BufferPassComposer> composer = std::make_shared<BufferPassComposer>(screenResolution);
+    composer->Add(std::make_shared<KernelPass>(kernel, 1.0f / 16.0f));
+    composer->Add(std::make_shared<GrainPass>(glm::vec2(1.0f), 0.1f));
+    scene->PassComposer = composer;
+    /* ------------------------------------------------------ */
+
+    int failures = 0;
+    for(int prePass = 0; prePass < 2; prePass++){
+        renderer->DepthPrePass = prePass == 1;
+
+        //Containers grow to their steady-state size during the first frames
+        for(int i = 0; i < WARM_UP_FRAMES; i++){
+            Time::Update();
+            renderer->Render(scene);
+            renderer->EndFrame();
+        }
+
+        size_t renderAllocations = 0;
+        size_t frameAllocations = 0;
+        for(int i = 0; i < frames; i++){
+            AllocationStats before = AllocationTracker::GetThreadStats();
+
+            Time::Update();
+            renderer->Render(scene);
+            renderer->EndFrame();
+
+            renderAllocations += renderer->GetFrameAllocationStats().Allocations;
+            frameAllocations += AllocationTracker::GetThreadStats().Allocations - before.Allocations;
+        }
+
+        std::printf("Depth pre-pass %s: %zu allocations in Render, %zu in the whole frame over %d frames\n", prePass ? "on" : "off", renderAllocations, frameAllocations, frames);
+        if(renderAllocations || frameAllocations) failures++;
+    }
+
+    std::printf(failures ? "FAIL\n" : "PASS\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,166 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/* GLEP - Check 1: Resize Stability */
+
+// Resizes the window to a new random size every frame, with fog, grain, blur and bloom passes,
+// and exits non-zero if the live GL texture/framebuffer/renderbuffer counts, the amount of GL objects
+// generated, or the post-processing uniform-list length change after warm-up. Then drags the window
+// for 120 frames and checks the debounce resizes the composer once the size settles.
+// Usage: GLEPCheck_1_resize_stability [resizes]
+
+#include <GLEP/core.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace GLEP;
+
+const glm::vec2 screenResolution = glm::vec2(800, 600);
+
+const int WARM_UP_FRAMES = 10;
+
+//Live GL object counts, kept by wrapping the loaded glGen*/glDelete* functions
+long liveTextures = 0, liveFramebuffers = 0, liveRenderbuffers = 0, generatedObjects = 0;
+
+PFNGLGENTEXTURESPROC realGenTextures;
+PFNGLDELETETEXTURESPROC realDeleteTextures;
+PFNGLGENFRAMEBUFFERSPROC realGenFramebuffers;
+PFNGLDELETEFRAMEBUFFERSPROC realDeleteFramebuffers;
+PFNGLGENRENDERBUFFERSPROC realGenRenderbuffers;
+PFNGLDELETERENDERBUFFERSPROC realDeleteRenderbuffers;
+
+long countNames(GLsizei n, const GLuint* ids){
+    long count = 0;
+    for(GLsizei i = 0; i < n; i++) count += ids[i] != 0;
+    return count;
+}
+
+void APIENTRY genTextures(GLsizei n, GLuint* ids){ realGenTextures(n, ids); liveTextures += n; generatedObjects += n; }
+void APIENTRY deleteTextures(GLsizei n, const GLuint* ids){ liveTextures -= countNames(n, ids); realDeleteTextures(n, ids); }
+void APIENTRY genFramebuffers(GLsizei n, GLuint* ids){ realGenFramebuffers(n, ids); liveFramebuffers += n; generatedObjects += n; }
+void APIENTRY deleteFramebuffers(GLsizei n, const GLuint* ids){ liveFramebuffers -= countNames(n, ids); realDeleteFramebuffers(n, ids); }
+void APIENTRY genRenderbuffers(GLsizei n, GLuint* ids){ realGenRenderbuffers(n, ids); liveRenderbuffers += n; generatedObjects += n; }
+void APIENTRY deleteRenderbuffers(GLsizei n, const GLuint* ids){ liveRenderbuffers -= countNames(n, ids); realDeleteRenderbuffers(n, ids); }
+
+size_t uniformCount(const std::shared_ptr<BufferPassComposer>& composer){
+    size_t count = 0;
+    for(const std::shared_ptr<BufferPass>& pass : composer->GetBufferPasses()){
+        count += pass->GetMaterial()->GetUniforms().size();
+
+        //Bloom's chain passes keep their own materials
+        if(pass->GetName() == "bloom_pass"){
+            std::shared_ptr<BloomPass> bloom = std::static_pointer_cast<BloomPass>(pass);
+            count += bloom->GetDownsamplePass()->GetMaterial()->GetUniforms().size();
+            count += bloom->GetUpsamplePass()->GetMaterial()->GetUniforms().size();
+        }
+    }
+
+    if(composer->GetFogPass()) count += composer->GetFogPass()->GetMaterial()->GetUniforms().size();
+    return count;
+}
+
+void renderFrame(const std::unique_ptr<Renderer>& renderer, const std::shared_ptr<Scene>& scene){
+    Time::Update();
+    renderer->Render(scene);
+    renderer->EndFrame();
+}
+
+int main(int argc, char** argv){
+    int resizes = argc > 1 ? std::atoi(argv[1]) : 1000;
+
+    /* -Initialise key objects (Window, Camera & Renderer)- */
+    std::shared_ptr<Window> window = std::make_shared<Window>(WindowState::WINDOWED, screenResolution, "GLEPCheck - Resize Stability");
+    std::shared_ptr<PerspectiveCamera> camera = std::make_shared<PerspectiveCamera>(45.0f, screenResolution.x / screenResolution.y, 0.01f, 100.0f);
+    std::unique_ptr<Renderer> renderer = std::make_unique<Renderer>(window, camera);
+    renderer->RenderShadows = false;
+    /* ------------------------------------------------------ */
+
+    realGenTextures = glad_glGenTextures;
+    realDeleteTextures = glad_glDeleteTextures;
+    realGenFramebuffers = glad_glGenFramebuffers;
+    realDeleteFramebuffers = glad_glDeleteFramebuffers;
+    realGenRenderbuffers = glad_glGenRenderbuffers;
+    realDeleteRenderbuffers = glad_glDeleteRenderbuffers;
+
+    glad_glGenTextures = genTextures;
+    glad_glDeleteTextures = deleteTextures;
+    glad_glGenFramebuffers = genFramebuffers;
+    glad_glDeleteFramebuffers = deleteFramebuffers;
+    glad_glGenRenderbuffers = genRenderbuffers;
+    glad_glDeleteRenderbuffers = deleteRenderbuffers;
+
+    std::shared_ptr<Scene> scene = std::make_shared<Scene>();
+    scene->Add(std::make_shared<Model>(std::make_shared<CubeGeometry>(1.0f, 1.0f, 1.0f), std::make_shared<UnlitMaterial>(Color::RED)));
+
+    std::shared_ptr<BufferPassComposer> composer = std::make_shared<BufferPassComposer>(screenResolution);
+    composer->Add(std::make_shared<FogPass>(0.1f, 10.0f, Color::WHITE));
+    composer->Add(std::make_shared<GrainPass>(glm::vec2(1.0f), 0.1f));
+    composer->Add(std::make_shared<BlurPass>(4.0f));
+    composer->Add(std::make_shared<BloomPass>(0.8f, 1.0f));
+    scene->PassComposer = composer;
+
+    int failures = 0;
+
+    /* -Settled resize every frame- */
+    std::mt19937 random(7);
+    renderer->ResizeDebounceFrames = 0;
+
+    long textures = 0, framebuffers = 0, renderbuffers = 0, generated = 0;
+    size_t uniforms = 0;
+    bool changed = false;
+    for(int i = 0; i < WARM_UP_FRAMES + resizes; i++){
+        window->SetResolution(glm::vec2(200 + random() % 600, 150 + random() % 450));
+        renderFrame(renderer, scene);
+
+        if(i == WARM_UP_FRAMES - 1){
+            textures = liveTextures;
+            framebuffers = liveFramebuffers;
+            renderbuffers = liveRenderbuffers;
+            generated = generatedObjects;
+            uniforms = uniformCount(composer);
+        } else if(i >= WARM_UP_FRAMES){
+            changed |= liveTextures != textures || liveFramebuffers != framebuffers || liveRenderbuffers != renderbuffers || uniformCount(composer) != uniforms;
+        }
+    }
+
+    std::printf("%d resizes: textures %ld -> %ld, framebuffers %ld -> %ld, renderbuffers %ld -> %ld, uniforms %zu -> %zu, GL objects generated %ld\n",
+        resizes, textures, liveTextures, framebuffers, liveFramebuffers, renderbuffers, liveRenderbuffers, uniforms, uniformCount(composer), generatedObjects - generated);
+    if(changed || generatedObjects != generated) failures++;
+
+    /* -Live drag, the size changes every frame before settling- */
+    renderer->ResizeDebounceFrames = 6;
+    unsigned int revision = composer->GetRevision();
+    int composerResizes = 0;
+    for(int i = 0; i < 140; i++){
+        if(i < 120) window->SetResolution(glm::vec2(400 + i * 3, 300 + i * 2));
+        renderFrame(renderer, scene);
+
+        if(composer->GetRevision() != revision){
+            composerResizes++;
+            revision = composer->GetRevision();
+        }
+    }
+
+    std::printf("120 frame drag with a 6 frame debounce: %d composer resizes, final %.0fx%.0f\n", composerResizes, composer->GetResolution().x, composer->GetResolution().y);
+    if(composerResizes != 1) failures++;
+
+    std::printf(failures ? "FAIL\n" : "PASS\n");
+    return failures ? 1 : 0;
+}
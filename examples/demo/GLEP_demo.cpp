@@ -212,6 +212,7 @@ void Update(){
         InterpManager::Update();
 
         controls->Update(renderer->TargetWindow);
+        audioEngine->Update(renderer->TargetCamera->Position);
 
         renderer->Bake(scene);
 
@@ -20,7 +20,9 @@
 
 #include <GLEP/audio/audio_engine.hpp>
 #include <GLEP/audio/audio_buffer.hpp>
+#include <GLEP/audio/audio_stream.hpp>
 #include <GLEP/audio/audio_source.hpp>
+#include <GLEP/audio/voice_manager.hpp>
 #include <GLEP/audio/audio_effect.hpp>
 
 #endif //AUDIO_HPP
\ No newline at end of file
@@ -19,9 +19,11 @@
 #define AUDIO_BUFFER_HPP
 
 #include <GLEP/core/utility/print.hpp>
+#include <GLEP/core/utility/mapped_file.hpp>
 
 #include <filesystem>
 #include <vector>
+#include <memory>
 
 #include <AL/al.h>
 #include <AL/alext.h>
@@ -30,12 +32,32 @@
 
 namespace GLEP::Audio{
 
+    struct AudioCacheStats{
+        int Hits = 0;
+        int Misses = 0;
+        int StaticBuffers = 0;
+        float DecodeTimeMs = 0.0f;
+        float CacheTimeMs = 0.0f;
+        size_t MappedBytes = 0;
+    };
+
     class AudioBuffer{
         private:
             uint32_t _ID;
             std::filesystem::path _filePath;
 
+            //Cached PCM handed to OpenAL without a copy, it must stay mapped for the buffer's lifetime
+            std::unique_ptr<MappedFile> _pcm;
+
+            static AudioCacheStats _cacheStats;
+
+            static uint32_t loadSoundFile(std::filesystem::path filePath, std::unique_ptr<MappedFile>* pcm);
+            static uint32_t loadCached(std::filesystem::path cachePath, uint64_t sourceHash, std::unique_ptr<MappedFile>* pcm);
+            static void writeCache(std::filesystem::path cachePath, uint64_t sourceHash, const short* samples, int64_t frames, int channels, int sampleRate);
+
         public:
+            static std::filesystem::path CacheDirectory;
+
             AudioBuffer(uint32_t bufferID);
             AudioBuffer(std::filesystem::path filePath);
             ~AudioBuffer();
@@ -48,12 +70,28 @@ namespace GLEP::Audio{
             /// @return Buffer ID
             uint32_t GetID();
 
+            /// @brief Get the length of the buffer.
+            /// @return Duration in seconds
+            float GetDuration();
+
+            /// @brief Get the number of channels in the buffer, only mono buffers are positioned by OpenAL.
+            /// @return Channel count
+            int GetChannels();
+
+            /// @brief Get if the buffer plays directly from a memory-mapped cache file.
+            /// @return If the buffer is static
+            bool GetIsStatic();
 
-            /// @brief Load a sound file.
+
+            /// @brief Load a sound file. If CacheDirectory is set, decoded samples are cached there keyed by a hash of the file, and later loads map the cache instead of decoding.
             /// @param filePath Sound file path
             /// @return Generated buffer ID
             static uint32_t LoadSoundFile(std::filesystem::path filePath);
 
+            /// @brief Get decode cache statistics for every sound file loaded so far.
+            /// @return Cache statistics
+            static AudioCacheStats GetCacheStats();
+
     };
 
 }
@@ -53,6 +53,11 @@ namespace GLEP::Audio{
             /// @return Sample rate
             float GetSampleRate();
 
+
+            /// @brief Move the listener and rank sources for voices, call once per frame so finished sources return their voice.
+            /// @param listenerPosition Position of the listener
+            void Update(glm::vec3 listenerPosition = glm::vec3(0.0f, 0.0f, 0.0f));
+
             /// @brief Synthesise a wave buffer based on parameters.
             /// @param sampleRate Sample rate of the buffer
             /// @param type Wave type to generate
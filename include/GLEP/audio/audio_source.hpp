@@ -19,9 +19,11 @@
 #define AUDIO_SOURCE_HPP
 
 #include <GLEP/audio/audio_buffer.hpp>
+#include <GLEP/audio/audio_stream.hpp>
 #include <GLEP/audio/audio_effect.hpp>
 
 #include <memory>
+#include <chrono>
 
 #include <AL/al.h>
 #include <glm/glm.hpp>
@@ -41,21 +43,39 @@ namespace GLEP::Audio{
     };
 
     class AudioSource{
+        friend class VoiceManager;
+
         private:
-            ALuint _alSource;
+            //Only set while the source holds a voice from the VoiceManager
+            ALuint _alSource = 0;
             float _pitch = 1.0f;
             float _gain = 1.0f;
             glm::vec3 _position = glm::vec3(0.0f, 0.0f, 0.0f);
             glm::vec3 _velocity = glm::vec3(0.0f, 0.0f, 0.0f);
             bool _loop = false;
+            bool _relative = false;
             std::shared_ptr<AudioBuffer> _buffer;
+            std::shared_ptr<AudioStream> _stream;
             std::vector<EffectSlot> _effects;
+            int _priority = 0;
+
+            //Logical playback, advanced by the clock while the source is virtual
+            AudioSourceState _state = AudioSourceState::INITIAL;
+            float _duration = 0.0f;
+            int _channels = 1;
+            float _offset = 0.0f;
+            std::chrono::steady_clock::time_point _offsetTime;
+            unsigned int _playOrder = 0;
 
             void initialize();
+            void realize(ALuint alSource);
+            ALuint virtualize();
+            float virtualTime();
             
         public:
             AudioSource();
             AudioSource(std::shared_ptr<AudioBuffer> buffer);
+            AudioSource(std::shared_ptr<AudioStream> stream);
             ~AudioSource();
 
             /// @brief Get the playback pitch.
@@ -66,7 +86,7 @@ namespace GLEP::Audio{
             /// @return Gain
             float GetGain();
 
-            /// @brief Get the playback postion (Currently unused).
+            /// @brief Get the playback postion.
             /// @return Position
             glm::vec3 GetPosition();
 
@@ -78,14 +98,34 @@ namespace GLEP::Audio{
             /// @return If the playback will loop
             bool GetLoop();
 
+            /// @brief Get if the position is relative to the listener rather than the world.
+            /// @return If the position is relative
+            bool GetRelative();
+
             /// @brief Get the currently assigned buffer.
             /// @return Currently assigned buffer
             std::shared_ptr<AudioBuffer> GetBuffer();
 
+            /// @brief Get the currently assigned stream.
+            /// @return Currently assigned stream
+            std::shared_ptr<AudioStream> GetStream();
+
+            /// @brief Get the current playback time of the assigned buffer or stream.
+            /// @return Playback time in seconds
+            float GetTime();
+
             /// @brief Get the current state of this source.
             /// @return Current state
             AudioSourceState GetState();
 
+            /// @brief Get the priority used to rank sources for voices.
+            /// @return Priority
+            int GetPriority();
+
+            /// @brief Get if the source has no voice, its playback time still advances but nothing is mixed.
+            /// @return If the source is virtual
+            bool GetIsVirtual();
+
 
             /// @brief Set the playback pitch.
             /// @param pitch Pitch to set
@@ -95,7 +135,7 @@ namespace GLEP::Audio{
             /// @param gain Gain to set
             void SetGain(float gain);
 
-            /// @brief Set the playback position (Currently unused).
+            /// @brief Set the playback position.
             /// @param position Position to set
             void SetPosition(glm::vec3 position);
 
@@ -107,9 +147,21 @@ namespace GLEP::Audio{
             /// @param loop Loop to set 
             void SetLoop(bool loop);
 
+            /// @brief Set if the position is relative to the listener rather than the world, for sounds that follow the listener such as music or UI.
+            /// @param relative Relative to set
+            void SetRelative(bool relative);
+
+            /// @brief Set the priority used to rank sources for voices, higher priority sources are given voices first.
+            /// @param priority Priority to set
+            void SetPriority(int priority);
+
             /// @brief Set the currently assigned buffer.
             /// @param buffer Buffer to set
             void SetBuffer(const std::shared_ptr<AudioBuffer>& buffer);
+
+            /// @brief Set a stream to play instead of a buffer, decoding it in chunks while playing.
+            /// @param stream Stream to set
+            void SetStream(const std::shared_ptr<AudioStream>& stream);
             
 
             /// @brief Add an audio effect.
@@ -117,7 +169,7 @@ namespace GLEP::Audio{
             void AddEffect(const std::shared_ptr<AudioEffect>& effect);
 
 
-            /// @brief Play the currenly assigned buffer.
+            /// @brief Play the currenly assigned buffer. If every voice is in use the source starts virtual until VoiceManager::Update gives it one.
             void Play();
 
             /// @brief Play a buffer.
@@ -130,6 +182,10 @@ namespace GLEP::Audio{
             /// @brief Stop the currently assigned buffer and reset its current duration.
             void Stop();
 
+            /// @brief Move playback of the currently assigned buffer or stream to a time.
+            /// @param seconds Time to seek to
+            void Seek(float seconds);
+
     };
 }
 
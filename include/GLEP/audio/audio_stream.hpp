@@ -0,0 +1,154 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef AUDIO_STREAM_HPP
+#define AUDIO_STREAM_HPP
+
+#include <GLEP/core/utility/print.hpp>
+
+#include <filesystem>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include <AL/al.h>
+#include <inttypes.h>
+#include <sndfile/sndfile.h>
+
+namespace GLEP::Audio{
+
+    struct AudioStreamStats{
+        int QueuedBuffers = 0;
+        int Underruns = 0;
+        size_t DecodedFrames = 0;
+    };
+
+    class AudioStream{
+        private:
+            std::filesystem::path _filePath;
+            SNDFILE* _file = nullptr;
+            SF_INFO _info = {};
+            ALenum _format = AL_NONE;
+
+            //Ring of AL buffers, the start frame of each queued buffer is kept to report the playback time
+            std::vector<ALuint> _buffers;
+            std::vector<ALuint> _free;
+            std::vector<sf_count_t> _queuedStarts;
+            int _queueHead = 0;
+            int _queued = 0;
+
+            std::vector<short> _chunk;
+            sf_count_t _cursor = 0;
+            bool _ended = false;
+            bool _loop = false;
+            bool _playing = false;
+            bool _finished = false;
+
+            ALuint _source = 0;
+            AudioStreamStats _stats;
+
+            std::thread _worker;
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            std::chrono::milliseconds _period;
+            bool _stopping = false;
+
+            void workerLoop();
+            void service();
+            bool fill();
+            void prefill();
+            void rewind(sf_count_t frame);
+
+        public:
+            /// @brief Open a sound file for streaming. Only the header is read, samples are decoded in chunks while playing.
+            /// @param filePath Sound file path
+            /// @param chunkFrames Number of frames decoded into each buffer
+            /// @param bufferCount Number of buffers kept queued on the source
+            AudioStream(std::filesystem::path filePath, int chunkFrames = 4096, int bufferCount = 4);
+            ~AudioStream();
+
+            AudioStream(const AudioStream&) = delete;
+            AudioStream& operator=(const AudioStream&) = delete;
+
+            /// @brief Get the audio file path.
+            /// @return Audio file path
+            std::filesystem::path GetFilePath();
+
+            /// @brief Get if the file was opened and has a supported format.
+            /// @return If the stream can be played
+            bool GetIsValid();
+
+            /// @brief Get the sample rate of the file.
+            /// @return Sample rate
+            int GetSampleRate();
+
+            /// @brief Get the length of the file.
+            /// @return Duration in seconds
+            float GetDuration();
+
+            /// @brief Get the number of channels in the file, only mono streams are positioned by OpenAL.
+            /// @return Channel count
+            int GetChannels();
+
+            /// @brief Get the current playback time.
+            /// @return Playback time in seconds
+            float GetTime();
+
+            /// @brief Get if the playback will loop.
+            /// @return If the playback will loop
+            bool GetLoop();
+
+            /// @brief Get if the stream is playing, including while it recovers from an underrun.
+            /// @return If the stream is playing
+            bool GetIsPlaying();
+
+            /// @brief Get streaming statistics.
+            /// @return Streaming statistics
+            AudioStreamStats GetStats();
+
+
+            /// @brief Set if the playback will loop, the end of the file runs straight into the start inside a single buffer.
+            /// @param loop Loop to set
+            void SetLoop(bool loop);
+
+
+            /// @brief Attach the stream to a source and start its decoding thread, a stream can only be attached to one source (Called by AudioSource).
+            /// @param source OpenAL source ID
+            void Attach(ALuint source);
+
+            /// @brief Stop playback, unqueue every buffer, and stop the decoding thread (Called by AudioSource).
+            void Detach();
+
+            /// @brief Play from the current position, or restart if already playing or finished (Called by AudioSource).
+            void Play();
+
+            /// @brief Pause at the current position (Called by AudioSource).
+            void Pause();
+
+            /// @brief Stop and rewind to the start (Called by AudioSource).
+            void Stop();
+
+            /// @brief Move playback to a time, keeping the source playing if it was (Called by AudioSource).
+            /// @param seconds Time to seek to
+            void Seek(float seconds);
+    };
+
+}
+
+#endif //AUDIO_STREAM_HPP
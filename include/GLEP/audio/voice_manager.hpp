@@ -0,0 +1,92 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef VOICE_MANAGER_HPP
+#define VOICE_MANAGER_HPP
+
+#include <GLEP/core/utility/print.hpp>
+
+#include <GLEP/audio/audio_source.hpp>
+
+#include <AL/al.h>
+#include <AL/alc.h>
+#include <glm/glm.hpp>
+
+namespace GLEP::Audio{
+
+    struct VoiceStats{
+        int Sources = 0;
+        int Voices = 0;
+        int Realized = 0;
+        int Virtual = 0;
+        int Realizations = 0;
+        int Virtualizations = 0;
+    };
+
+    class VoiceManager{
+        private:
+            static int _deviceLimit;
+            static unsigned int _playOrder;
+            static VoiceStats _stats;
+
+            static int capacity();
+            static bool acquire(ALuint& alSource);
+            static void release(AudioSource* source);
+
+        public:
+            static int MaxVoices;
+            static float AudibleGain;
+            static float RealizedBias;
+
+            /// @brief Read the device's source limit (Called by AudioEngine).
+            /// @param alDevice OpenAL device
+            static void Initialize(ALCdevice* alDevice);
+
+            /// @brief Release every voice and delete the pooled OpenAL sources (Called by AudioEngine).
+            static void Shutdown();
+
+
+            /// @brief Get voice statistics, counts are for the last update.
+            /// @return Voice statistics
+            static VoiceStats GetStats();
+
+
+            /// @brief Track a source so it can be given a voice (Called by AudioSource).
+            /// @param source Source to track
+            static void Register(AudioSource* source);
+
+            /// @brief Stop tracking a source and return its voice to the pool (Called by AudioSource).
+            /// @param source Source to stop tracking
+            static void Unregister(AudioSource* source);
+
+            /// @brief Give a source a free voice if there is one, reclaiming the voice of a paused or finished source when the pool is full (Called by AudioSource).
+            /// @param source Source requesting a voice
+            static void Request(AudioSource* source);
+
+            /// @brief Get the next play order, used to rank older sources first (Called by AudioSource).
+            /// @return Play order
+            static unsigned int NextPlayOrder();
+
+
+            /// @brief Rank playing sources by priority, then gain (distance-attenuated for mono, world-positioned sources), then age, and give the highest ranked the pool's voices. Inaudible and lower ranked sources are virtualized, keeping their playback time, and are realized again from that time once they rank high enough (Called by AudioEngine).
+            /// @param listenerPosition Position of the listener
+            static void Update(glm::vec3 listenerPosition);
+    };
+
+}
+
+#endif //VOICE_MANAGER_HPP
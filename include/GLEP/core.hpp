@@ -42,6 +42,7 @@
 #include <GLEP/core/camera.hpp>
 #include <GLEP/core/scene.hpp>
 #include <GLEP/core/renderer.hpp>
+#include <GLEP/core/frame_capture.hpp>
 
 #include <GLEP/core/utility/export.hpp>
 
@@ -20,14 +20,18 @@
 
 #include <GLEP/core/time.hpp>
 #include <GLEP/core/framebuffer.hpp>
+#include <GLEP/core/render_graph.hpp>
 #include <GLEP/core/geometry.hpp>
 #include <GLEP/core/material.hpp>
 #include <GLEP/core/mesh.hpp>
+#include <GLEP/core/utility/opengl.hpp>
 
 #include <string>
 #include <vector>
 #include <memory>
 #include <filesystem>
+#include <regex>
+#include <sstream>
 
 #include <nlohmann/json.hpp>
 #include <glad/glad.h>
@@ -42,12 +46,16 @@ namespace GLEP{
             std::string _name = "buffer_pass";
 
             std::shared_ptr<Framebuffer> _framebuffer;
+            std::shared_ptr<Framebuffer> _depthFramebuffer;
             std::shared_ptr<Mesh> _mesh;
 
+            //Passes drawn in several steps are expanded by the composer and never fused
+            bool _multiPass = false;
+
         public:
             BufferPass(std::shared_ptr<Material> material);
 
-            /// @brief Get the framebuffer of the pass.
+            /// @brief Get the framebuffer the pass reads from.
             /// @return Framebuffer
             std::shared_ptr<Framebuffer> GetFramebuffer();
             
@@ -60,13 +68,19 @@ namespace GLEP{
             std::string GetName();
 
 
-            /// @brief Initialize the buffers' resolution
-            /// @param resolution Buffer resolution
-            void InitializeBuffer(glm::vec2 resolution);
+            /// @brief Get if the pass' shader samples the depth buffer.
+            /// @return If depth is read
+            bool GetReadsDepth();
+
+            /// @brief Get if the pass' shader only samples its source color at the current texel, allowing it to be fused with neighbouring per-pixel passes.
+            /// @return If the pass is per-pixel
+            bool GetIsPerPixel();
 
 
-            /// @brief Bind the framebuffer as the active framebuffer
-            void Bind();
+            /// @brief Set the framebuffers the pass reads from.
+            /// @param framebuffer Framebuffer to read color from
+            /// @param depthFramebuffer Framebuffer to read depth from (If this is nullptr depth is read from framebuffer instead)
+            void SetSource(const std::shared_ptr<Framebuffer>& framebuffer, const std::shared_ptr<Framebuffer>& depthFramebuffer = nullptr);
             
             /// @brief Render the material to a full-screen quad
             void Render();
@@ -146,21 +160,135 @@ namespace GLEP{
 
     };
 
+    class UpsamplePass : public BufferPass {
+        public:
+            UpsamplePass(float sharpness);
+
+            /// @brief Deserialize data from JSON format
+            /// @param data UpsamplePass data in JSON format
+            /// @return Deserialized UpsamplePass
+            static std::shared_ptr<UpsamplePass> FromJson(const json& data);
+
+    };
+
+    enum class BlurType{
+        GAUSSIAN,
+        BOX
+    };
+
+    class BlurPass : public BufferPass {
+        private:
+            float _radius;
+            BlurType _type;
+
+            void updateWeights();
+
+        public:
+            /// @brief Maximum taps per direction, each tap past the center covers two texels
+            static const int MAX_TAPS = 32;
+
+            /// @brief Widest radius in texels a BlurPass can cover, wider blurs should use a BloomPass instead
+            static const int MAX_RADIUS = (MAX_TAPS - 1) * 2;
+
+            BlurPass(float radius, BlurType type = BlurType::GAUSSIAN);
+
+            /// @brief Get the blur radius.
+            /// @return Radius in texels
+            float GetRadius();
+
+            /// @brief Get the blur type.
+            /// @return Blur type
+            BlurType GetType();
+
+            /// @brief Set the blur radius, clamped to MAX_RADIUS.
+            /// @param radius Radius in texels
+            void SetRadius(float radius);
+
+            /// @brief Set the blur type.
+            /// @param type Blur type
+            void SetType(BlurType type);
+
+            /// @brief Deserialize data from JSON format
+            /// @param data BlurPass data in JSON format
+            /// @return Deserialized BlurPass
+            static std::shared_ptr<BlurPass> FromJson(const json& data);
+
+    };
+
+    class BloomPass : public BufferPass {
+        private:
+            int _levels;
+
+            std::shared_ptr<BufferPass> _downsamplePass;
+            std::shared_ptr<BufferPass> _upsamplePass;
+
+        public:
+            BloomPass(float threshold, float intensity, int levels = 6);
+
+            /// @brief Get the number of mip levels the bloom is blurred across.
+            /// @return Mip levels
+            int GetLevels();
+
+            /// @brief Get the pass that thresholds and downsamples each mip level.
+            /// @return Downsample pass
+            std::shared_ptr<BufferPass> GetDownsamplePass();
+
+            /// @brief Get the pass that upsamples and accumulates each mip level.
+            /// @return Upsample pass
+            std::shared_ptr<BufferPass> GetUpsamplePass();
+
+            /// @brief Deserialize data from JSON format
+            /// @param data BloomPass data in JSON format
+            /// @return Deserialized BloomPass
+            static std::shared_ptr<BloomPass> FromJson(const json& data);
+
+    };
+
+    class FusedPass : public BufferPass {
+        private:
+            std::vector<std::shared_ptr<BufferPass>> _passes;
+
+        public:
+            FusedPass(const std::vector<std::shared_ptr<BufferPass>>& passes);
+
+            /// @brief Get the passes concatenated into this pass.
+            /// @return Fused passes
+            std::vector<std::shared_ptr<BufferPass>> GetPasses();
+
+    };
+
     class BufferPassComposer{
         private:
             glm::vec2 _resolution;
+            unsigned int _revision = 0;
 
-            std::shared_ptr<RenderPass> _objectPass;
-            std::shared_ptr<RenderPass> _skyboxPass;
-            std::shared_ptr<RenderPass> _renderPass;
+            std::shared_ptr<RenderPass> _copyPass;
+            std::shared_ptr<UpsamplePass> _upsamplePass;
             std::shared_ptr<FogPass> _fogPass;
 
             std::vector<std::shared_ptr<BufferPass>> _bufferPasses;
-
-            void initialize();
+            std::vector<std::shared_ptr<BufferPass>> _chain;
+            bool _chainFused = false;
+            bool _chainDirty = true;
+
+            void updateChain();
+            FramebufferDesc targetDesc();
+            void beginPass();
+            void endPass();
+            void renderPass(const std::shared_ptr<BufferPass>& pass, const std::shared_ptr<Framebuffer>& source, const std::shared_ptr<Framebuffer>& depthSource);
+            void addBlurPasses(RenderGraph& graph, const std::shared_ptr<BlurPass>& blur, RenderGraphResource source, RenderGraphResource target);
+            void addBloomPasses(RenderGraph& graph, const std::shared_ptr<BloomPass>& bloom, RenderGraphResource source, RenderGraphResource target);
 
         public:
             Color ClearColor = Color::BLACK;
+            bool FusePasses = false;
+            float UpsampleSharpness = 0.5f;
+
+            /// @brief Color format of the scene and intermediate targets
+            FramebufferColor ColorFormat = FramebufferColor::RGB8;
+
+            /// @brief Multisample count of the scene target, matching the window by default (Passes after it are single-sampled)
+            int Samples = (int)GL_MULTISAMPLES;
 
             BufferPassComposer(glm::vec2 resolution);
 
@@ -171,11 +299,23 @@ namespace GLEP{
             /// @brief Get the assigned buffer passes.
             /// @return Buffer passes
             std::vector<std::shared_ptr<BufferPass>> GetBufferPasses();
+
+            /// @brief Get the passes that are rendered, with consecutive per-pixel passes replaced by a FusedPass if FusePasses is enabled.
+            /// @return Rendered passes
+            std::vector<std::shared_ptr<BufferPass>> GetRenderedPasses();
             
+            /// @brief Get if the fog pass or any buffer pass samples the scene depth, in which case the scene target keeps depth in a texture.
+            /// @return If scene depth is read
+            bool GetReadsDepth();
+
             /// @brief Get the target render resolution.
             /// @return Render resolution
             glm::vec2 GetResolution();
 
+            /// @brief Get the revision of the pass chain, incremented whenever passes are added or the resolution changes.
+            /// @return Revision
+            unsigned int GetRevision();
+
             /// @brief Set the target render resolution.
             /// @param resolution Render resolution to set
             void SetResolution(glm::vec2 resolution);
@@ -189,14 +329,12 @@ namespace GLEP{
             void Add(std::shared_ptr<FogPass> fogPass);
             
 
-            /// @brief Bind the first buffer pass in the chain, binding the framebuffer data of a render.
-            void NewFrame();
-            
-            /// @brief Bind the framebuffer for the skybox render (Only if a fog pass is assigned).
-            void PreSkybox();
-            
-            /// @brief Render each buffer pass in the chain consecutively.
-            void Render();
+            /// @brief Add the fog pass and each buffer pass in the chain to a render graph, ping-ponging between transient targets.
+            /// @param graph Target render graph
+            /// @param objects Resource the scene objects were rendered to
+            /// @param skybox Resource the skybox was rendered to (Only read if a fog pass is assigned)
+            /// @param output Resource the final pass renders to, upsampled to if its resolution differs from the composer's
+            void AddPasses(RenderGraph& graph, RenderGraphResource objects, RenderGraphResource skybox, RenderGraphResource output);
 
             
             /// @brief Serialize data to JSON format.
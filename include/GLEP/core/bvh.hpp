@@ -0,0 +1,182 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef BVH_HPP
+#define BVH_HPP
+
+#include <GLEP/core/utility/math.hpp>
+
+#include <GLEP/core/scene_object.hpp>
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+namespace GLEP {
+
+    class SceneBVH{
+        public:
+            struct Node{
+                AABB Bounds;
+                int Parent = -1;
+                int Left = -1;
+                int Right = -1;
+                SceneObject* Object = nullptr;
+                //Transform and bounds revisions of the leaf's objects when its bounds were last computed
+                unsigned int Revision = 0;
+
+                bool IsLeaf() const { return Left < 0; }
+            };
+
+        private:
+            std::vector<Node> _nodes;
+            std::vector<int> _freeNodes;
+            int _root = -1;
+
+            std::unordered_map<SceneObject*, int> _leaves;
+            std::unordered_map<SceneObject*, AABB> _ownBounds;
+            std::unordered_map<SceneObject*, AABB> _subtreeBounds;
+
+            std::vector<int> _stack;
+
+            int allocateNode();
+            void freeNode(int index);
+
+            AABB computeBounds(SceneObject* object);
+            void forgetBounds(SceneObject* object);
+            unsigned int revisionOf(SceneObject* object);
+            bool refitLeaf(int leaf, unsigned int revision);
+            void refitOwner(SceneObject* object);
+
+            int buildRecursive(std::vector<int>& leaves, int begin, int end);
+            void insertLeaf(int leaf);
+            void removeLeaf(int leaf);
+            void refitFrom(int index);
+            void rotate(int index);
+            void swapNodes(int upper, int lower);
+
+            template <typename Test>
+            void queryObject(SceneObject* object, Test& test, std::vector<SceneObject*>& results){
+                auto subtree = _subtreeBounds.find(object);
+                if(subtree == _subtreeBounds.end() || !test(subtree->second)) return;
+
+                if(test(_ownBounds[object])) results.push_back(object);
+
+                //Children that are scene objects themselves have their own leaf
+                for(std::shared_ptr<SceneObject>& child : object->GetChildren()){
+                    if(_leaves.count(child.get())) continue;
+                    queryObject(child.get(), test, results);
+                }
+            }
+
+            template <typename Test>
+            void query(Test& test, std::vector<SceneObject*>& results){
+                if(_root < 0) return;
+
+                _stack.clear();
+                _stack.push_back(_root);
+                while(!_stack.empty()){
+                    int index = _stack.back();
+                    _stack.pop_back();
+
+                    if(!test(_nodes[index].Bounds)) continue;
+
+                    if(_nodes[index].IsLeaf()){
+                        queryObject(_nodes[index].Object, test, results);
+                    } else {
+                        _stack.push_back(_nodes[index].Left);
+                        _stack.push_back(_nodes[index].Right);
+                    }
+                }
+            }
+
+        public:
+            SceneBVH();
+
+
+            /// @brief Get the amount of nodes currently in use.
+            /// @return Node count
+            int GetNodeCount();
+
+            /// @brief Get the bounds enclosing every object in the hierarchy.
+            /// @return Root bounds
+            AABB GetRootBounds();
+
+            /// @brief Get the world bounds of an object and its children.
+            /// @param object Target object
+            /// @return Bounds, will return nullptr if the object isn't in the hierarchy
+            const AABB* GetBounds(SceneObject* object);
+
+
+            /// @brief Rebuild the hierarchy from scratch using the surface area heuristic.
+            /// @param objects Top level scene objects
+            void Build(const std::vector<std::shared_ptr<SceneObject>>& objects);
+
+            /// @brief Insert an object and its children.
+            /// @param object Object to insert
+            void Insert(SceneObject* object);
+
+            /// @brief Remove an object and its children.
+            /// @param object Object to remove
+            void Remove(SceneObject* object);
+
+            /// @brief Refit the branches of objects whose transform or geometry changed since their bounds were last computed, run after the scene's transforms are updated.
+            /// @return Amount of leaves that were refit
+            int Refit();
+
+            /// @brief Remove every object.
+            void Clear();
+
+
+            /// @brief Find all objects with bounds inside a frustum.
+            /// @param frustum Query frustum
+            /// @param results Found objects are appended to this
+            void QueryFrustum(const Frustum& frustum, std::vector<SceneObject*>& results);
+
+            /// @brief Find all objects with bounds overlapping a sphere.
+            /// @param center Sphere center
+            /// @param radius Sphere radius
+            /// @param results Found objects are appended to this
+            void QuerySphere(glm::vec3 center, float radius, std::vector<SceneObject*>& results);
+
+            /// @brief Find all objects with bounds overlapping a box.
+            /// @param bounds Query box
+            /// @param results Found objects are appended to this
+            void QueryAABB(const AABB& bounds, std::vector<SceneObject*>& results);
+
+            /// @brief Find all objects with bounds hit by a ray.
+            /// @param origin Ray origin
+            /// @param direction Ray direction
+            /// @param maxDistance Maximum distance along the ray
+            /// @param results Found objects are appended to this
+            void QueryRay(glm::vec3 origin, glm::vec3 direction, float maxDistance, std::vector<SceneObject*>& results);
+
+            /// @brief Find the object with the closest bounds hit by a ray.
+            /// @param origin Ray origin
+            /// @param direction Ray direction
+            /// @param maxDistance Maximum distance along the ray
+            /// @param distance Distance to the hit bounds
+            /// @return Hit object, will return nullptr if nothing was hit
+            SceneObject* Raycast(glm::vec3 origin, glm::vec3 direction, float maxDistance, float& distance);
+    };
+
+}
+
+#endif //BVH_HPP
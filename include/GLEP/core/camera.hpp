@@ -39,6 +39,7 @@ namespace GLEP{
 
             glm::mat4 _projectionMatrix;
             glm::mat4 _viewMatrix;
+            unsigned int _viewRevision = ~0u;
 
             glm::vec3 _front;
             glm::vec3 _right;
@@ -66,7 +67,7 @@ namespace GLEP{
             /// @return Projection matrix
             glm::mat4 GetProjectionMatrix();
 
-            /// @brief Get the view matrix.
+            /// @brief Get the view matrix, cached until the camera's world transform changes.
             /// @return View matrix
             glm::mat4 GetViewMatrix();
 
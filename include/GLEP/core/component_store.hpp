@@ -0,0 +1,246 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef COMPONENT_STORE_HPP
+#define COMPONENT_STORE_HPP
+
+#include <GLEP/core/scene_object.hpp>
+#include <GLEP/core/object_component.hpp>
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+
+namespace GLEP {
+
+    class IComponentPool{
+        public:
+            virtual ~IComponentPool() = default;
+
+            /// @brief Start components added since the last update and run the pool's system.
+            virtual void Update() = 0;
+
+            /// @brief Remove the component owned by an object, if any.
+            /// @param owner Owning object
+            virtual void Remove(SceneObject* owner) = 0;
+
+            /// @brief Get the amount of components in the pool.
+            /// @return Component count
+            virtual size_t GetCount() = 0;
+    };
+
+    template <typename T>
+    class ComponentPool : public IComponentPool{
+        private:
+            std::vector<T> _components;
+            std::vector<SceneObject*> _owners;
+            std::unordered_map<SceneObject*, size_t> _indices;
+            std::vector<SceneObject*> _pendingStart;
+
+            std::function<void(ComponentPool<T>&)> _system;
+
+        public:
+            /// @brief Add a component for an object, replacing any component of the same type it already has.
+            /// @param owner Owning object, must be managed by a shared pointer
+            /// @param component Component to store
+            /// @return Stored component, valid until a component of this type is added or removed
+            T& Add(SceneObject* owner, T component){
+                component.Initialize(owner->weak_from_this());
+
+                auto it = _indices.find(owner);
+                if(it != _indices.end()){
+                    _components[it->second] = std::move(component);
+                    return _components[it->second];
+                }
+
+                _indices[owner] = _components.size();
+                _components.push_back(std::move(component));
+                _owners.push_back(owner);
+                _pendingStart.push_back(owner);
+
+                return _components.back();
+            }
+
+            /// @brief Find the component owned by an object.
+            /// @param owner Owning object
+            /// @return Found component, will return nullptr if not found
+            T* Get(SceneObject* owner){
+                auto it = _indices.find(owner);
+                if(it == _indices.end()) return nullptr;
+                return &_components[it->second];
+            }
+
+            void Remove(SceneObject* owner) override{
+                auto it = _indices.find(owner);
+                if(it == _indices.end()) return;
+
+                //Swap with the last component to keep the array dense
+                size_t index = it->second;
+                size_t last = _components.size() - 1;
+                if(index != last){
+                    _components[index] = std::move(_components[last]);
+                    _owners[index] = _owners[last];
+                    _indices[_owners[index]] = index;
+                }
+
+                _components.pop_back();
+                _owners.pop_back();
+                _indices.erase(owner);
+                _pendingStart.erase(std::remove(_pendingStart.begin(), _pendingStart.end(), owner), _pendingStart.end());
+            }
+
+            size_t GetCount() override{ return _components.size(); }
+
+            /// @brief Get the dense component array, indices match GetOwners().
+            /// @return Components
+            std::vector<T>& GetComponents(){ return _components; }
+
+            /// @brief Get the owner of every component in the pool.
+            /// @return Owning objects
+            const std::vector<SceneObject*>& GetOwners(){ return _owners; }
+
+            /// @brief Replace the per-component Update calls with a function that processes the whole pool.
+            /// @param system System function, pass nullptr to restore the default
+            void SetSystem(std::function<void(ComponentPool<T>&)> system){ _system = system; }
+
+            void Update() override{
+                for(SceneObject* owner : _pendingStart){
+                    _components[_indices[owner]].Start();
+                }
+                _pendingStart.clear();
+
+                if(_system){
+                    _system(*this);
+                    return;
+                }
+
+                //Qualified call so the compiler can resolve it statically and inline it
+                for(T& c : _components){
+                    c.T::Update();
+                }
+            }
+    };
+
+    class ComponentStore{
+        private:
+            std::vector<std::unique_ptr<IComponentPool>> _pools;
+            std::unordered_map<std::type_index, IComponentPool*> _poolIndex;
+
+        public:
+            ComponentStore();
+
+            ComponentStore(const ComponentStore&) = delete;
+            ComponentStore& operator=(const ComponentStore&) = delete;
+
+
+            /// @brief Get the pool for a component type, creating it if needed. Pools update in creation order.
+            /// @tparam T Component type
+            /// @return Component pool
+            template <typename T>
+            ComponentPool<T>& GetPool(){
+                auto it = _poolIndex.find(std::type_index(typeid(T)));
+                if(it != _poolIndex.end()) return *static_cast<ComponentPool<T>*>(it->second);
+
+                _pools.push_back(std::make_unique<ComponentPool<T>>());
+                _poolIndex[std::type_index(typeid(T))] = _pools.back().get();
+                return *static_cast<ComponentPool<T>*>(_pools.back().get());
+            }
+
+            /// @brief Construct a component in contiguous storage for an object.
+            /// @tparam T Component type
+            /// @param owner Owning object
+            /// @param args Component constructor arguments
+            /// @return Stored component, valid until a component of this type is added or removed
+            template <typename T, typename... Args>
+            T& Add(SceneObject* owner, Args&&... args){
+                return GetPool<T>().Add(owner, T(std::forward<Args>(args)...));
+            }
+
+            /// @brief Find the component of a type owned by an object.
+            /// @tparam T Component type
+            /// @param owner Owning object
+            /// @return Found component, will return nullptr if not found
+            template <typename T>
+            T* Get(SceneObject* owner){
+                auto it = _poolIndex.find(std::type_index(typeid(T)));
+                if(it == _poolIndex.end()) return nullptr;
+                return static_cast<ComponentPool<T>*>(it->second)->Get(owner);
+            }
+
+            /// @brief Remove the component of a type owned by an object.
+            /// @tparam T Component type
+            /// @param owner Owning object
+            template <typename T>
+            void Remove(SceneObject* owner){
+                auto it = _poolIndex.find(std::type_index(typeid(T)));
+                if(it != _poolIndex.end()) it->second->Remove(owner);
+            }
+
+            /// @brief Set the system function that updates every component of a type.
+            /// @tparam T Component type
+            /// @param system System function
+            template <typename T>
+            void SetSystem(std::function<void(ComponentPool<T>&)> system){
+                GetPool<T>().SetSystem(system);
+            }
+
+
+            /// @brief Get the amount of stored components across all pools.
+            /// @return Component count
+            size_t GetCount();
+
+            /// @brief Let an object and its children add stored components through the SceneObject facade.
+            /// @param object Object to attach
+            void Attach(SceneObject* object);
+
+            /// @brief Remove every stored component of an object and its children.
+            /// @param object Object to detach
+            void Detach(SceneObject* object);
+
+            /// @brief Update each pool in turn.
+            void Update();
+    };
+
+
+    template <typename T, typename... Args>
+    T* SceneObject::AddStoredComponent(Args&&... args){
+        if(!_componentStore){
+            Print(PrintCode::ERROR, "SCENE_OBJECT", "Object must be added to a scene before adding stored components.");
+            return nullptr;
+        }
+        return &_componentStore->Add<T>(this, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    T* SceneObject::GetStoredComponent(){
+        if(!_componentStore) return nullptr;
+        return _componentStore->Get<T>(this);
+    }
+
+    template <typename T>
+    void SceneObject::RemoveStoredComponent(){
+        if(_componentStore) _componentStore->Remove<T>(this);
+    }
+
+}
+
+#endif //COMPONENT_STORE_HPP
@@ -23,6 +23,7 @@
 #include <GLEP/core/texture.hpp>
 #include <GLEP/core/framebuffer.hpp>
 #include <GLEP/core/camera.hpp>
+#include <GLEP/core/time.hpp>
 
 #include <vector>
 #include <memory>
@@ -34,9 +35,15 @@ namespace GLEP{
 
     using json = nlohmann::ordered_json;
 
+    enum class ProbeUpdateMode{
+        STATIC,
+        ON_DEMAND,
+        REALTIME
+    };
+
     class CubeMap{
         protected:            
-            unsigned int _ID;
+            unsigned int _ID = 0;
             int _width;
             int _height;
             int _nrChannels;
@@ -88,7 +95,8 @@ namespace GLEP{
 
 
             /// @brief Set active texture slot and bind texture.
-            void Bind();
+            /// @param unit Texture unit to bind to
+            void Bind(int unit = 6);
 
 
             /// @brief Serialize data to JSON format.
@@ -139,13 +147,26 @@ namespace GLEP{
             std::shared_ptr<Camera> _camera;
             std::shared_ptr<Framebuffer> _framebuffer;
 
+            unsigned int _layeredFramebuffer = 0;
+            unsigned int _layeredDepthBuffer = 0;
+
+            int _pendingFaces = 0x3F;
+            float _lastUpdateTime = -1.0f;
+
             void initialize() override;
+            void initializeLayered();
 
             static const glm::vec3 DIRECTIONS[6];
             static const glm::vec3 UP_VECTORS[6];
 
         public:
+            static const int ALL_FACES = 0x3F;
+
+            ProbeUpdateMode UpdateMode = ProbeUpdateMode::STATIC;
+            float InfluenceRadius = 5.0f;
+
             BakedCubeMap(glm::vec3 position, int bufferSize = 1024);
+            ~BakedCubeMap();
 
             /// @brief Get the cube map center position.
             /// @return Center postion
@@ -160,6 +181,26 @@ namespace GLEP{
             std::shared_ptr<Framebuffer> GetFramebuffer();
 
 
+            /// @brief Get the faces still waiting to be rendered.
+            /// @return Bitmask of pending face indices
+            int GetPendingFaces();
+
+            /// @brief Get if every face has been rendered at least once.
+            /// @return If the cube map has been baked
+            bool GetIsBaked();
+
+            /// @brief Get the elapsed time when the last full update completed.
+            /// @return Last update time, will return -1 if never baked
+            float GetLastUpdateTime();
+
+            /// @brief Queue all six faces to be re-rendered by the probe scheduler.
+            void RequestUpdate();
+
+            /// @brief Mark a face as rendered, completing the update once no faces are pending.
+            /// @param index Cube map direction index
+            void MarkFaceUpdated(int index);
+
+
             /// @brief Set the index of the six possible cube map directions.
             /// @param index Cube map direction index
             void SetDirection(int index);
@@ -172,6 +213,16 @@ namespace GLEP{
             /// @param index Cube map direction index
             void BindBuffer(int index);
 
+            /// @brief Bind the layered framebuffer, attaching every cube map face at once or a single face.
+            /// @param index Cube map direction index, -1 attaches all six faces for layered rendering
+            /// @return If the layered framebuffer is complete
+            bool BindLayeredBuffer(int index = -1);
+
+            /// @brief Get the combined projection and view matrix of a cube map direction.
+            /// @param index Cube map direction index
+            /// @return View projection matrix
+            glm::mat4 GetFaceViewProjection(int index);
+
             /// @brief Unbind framebuffer
             void UnbindBuffer();
 
@@ -0,0 +1,168 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAME_CAPTURE_HPP
+#define FRAME_CAPTURE_HPP
+
+#include <GLEP/core/utility/print.hpp>
+
+#include <GLEP/core/framebuffer.hpp>
+#include <GLEP/core/window.hpp>
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <filesystem>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace GLEP {
+
+    enum class CaptureFormat{
+        PNG,
+        JPG,
+        RAW,
+        Y4M
+    };
+
+    enum class CaptureOverflow{
+        DROP,
+        BLOCK
+    };
+
+    struct FrameCaptureStats{
+        int Captured = 0;
+        int Encoded = 0;
+        int Dropped = 0;
+        int Failed = 0;
+        int InFlight = 0;
+        int Queued = 0;
+    };
+
+    class FrameCapture{
+        private:
+            enum class JobState{
+                FREE,
+                READING,
+                QUEUED,
+                ENCODING
+            };
+
+            struct ReadbackSlot{
+                unsigned int Buffer = 0;
+                GLsync Fence = nullptr;
+                size_t Capacity = 0;
+                int Width = 0;
+                int Height = 0;
+                unsigned int Sequence = 0;
+            };
+
+            struct EncodeJob{
+                JobState State = JobState::FREE;
+                std::vector<unsigned char> Pixels;
+                std::vector<unsigned char> Planes;
+                int Width = 0;
+                int Height = 0;
+                unsigned int Sequence = 0;
+            };
+
+            std::filesystem::path _path;
+            CaptureFormat _format;
+
+            //Readback ring, slots are retired oldest first so frames reach the encoder in order
+            std::vector<ReadbackSlot> _slots;
+            int _head = 0;
+            int _inFlight = 0;
+            unsigned int _sequence = 0;
+
+            std::vector<EncodeJob> _jobs;
+            std::vector<std::thread> _workers;
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            bool _stopping = false;
+
+            //Y4M frames are converted in parallel but written in sequence order
+            std::ofstream _stream;
+            std::mutex _streamMutex;
+            std::condition_variable _streamCondition;
+            unsigned int _nextWrite = 0;
+            glm::ivec2 _streamResolution = glm::ivec2(0);
+
+            FrameCaptureStats _stats;
+
+            void workerLoop();
+            void encode(EncodeJob& job);
+            bool writeImage(EncodeJob& job);
+            bool writeStream(EncodeJob& job);
+            bool retire(bool wait);
+            bool capture(unsigned int framebuffer, int width, int height);
+
+        public:
+            int Quality = 90;
+            int FrameRate = 60;
+            CaptureOverflow Overflow = CaptureOverflow::DROP;
+
+            /// @brief Create an asynchronous frame capture. Frames are copied into pixel pack buffers and read back a few frames later, then encoded on background threads.
+            /// @param path Directory to write image sequences to, or the file to write a Y4M stream to
+            /// @param format Format of the captured frames
+            /// @param latency Number of frames a readback is given to complete before it is waited on
+            /// @param queuedFrames Maximum number of read back frames waiting to be encoded
+            /// @param threads Number of encoding threads, 0 uses the hardware concurrency
+            FrameCapture(std::filesystem::path path, CaptureFormat format = CaptureFormat::PNG, int latency = 3, int queuedFrames = 8, unsigned int threads = 0);
+            ~FrameCapture();
+
+            FrameCapture(const FrameCapture&) = delete;
+            FrameCapture& operator=(const FrameCapture&) = delete;
+
+
+            /// @brief Get the path frames are written to.
+            /// @return Capture path
+            const std::filesystem::path& GetPath();
+
+            /// @brief Get the format frames are written in.
+            /// @return Capture format
+            CaptureFormat GetFormat();
+
+            /// @brief Get capture statistics, including frames dropped because the readback ring or encode queue was full.
+            /// @return Capture statistics
+            FrameCaptureStats GetStats();
+
+
+            /// @brief Queue a readback of a framebuffer's color buffer, resolving it first if it is multisampled.
+            /// @param framebuffer Buffer to capture
+            /// @return If the frame was queued, false if it was dropped
+            bool Capture(const std::shared_ptr<Framebuffer>& framebuffer);
+
+            /// @brief Queue a readback of the window's back buffer, call before swapping buffers.
+            /// @param window Window to capture
+            /// @return If the frame was queued, false if it was dropped
+            bool Capture(const std::shared_ptr<Window>& window);
+
+            /// @brief Hand completed readbacks to the encoding threads without blocking (Called by Capture).
+            void Update();
+
+            /// @brief Wait for every queued frame to be read back and encoded.
+            void Flush();
+    };
+
+}
+
+#endif //FRAME_CAPTURE_HPP
@@ -20,37 +20,83 @@
 
 #include <GLEP/core/utility/print.hpp>
 
+#include <cstddef>
+
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
 namespace GLEP{
 
+    enum class FramebufferColor{
+        NONE,
+        RGB8,
+        RGBA8,
+        RGB10A2,
+        R11G11B10F,
+        RGBA16F
+    };
+
+    enum class FramebufferDepth{
+        NONE,
+        RENDERBUFFER,
+        TEXTURE
+    };
+
+    struct FramebufferDesc{
+        FramebufferColor Color = FramebufferColor::RGB8;
+        FramebufferDepth Depth = FramebufferDepth::TEXTURE;
+        int Samples = 0;
+
+        bool operator==(const FramebufferDesc& other) const {
+            return Color == other.Color && Depth == other.Depth && Samples == other.Samples;
+        }
+
+        bool operator!=(const FramebufferDesc& other) const {
+            return !(*this == other);
+        }
+    };
+
     class Framebuffer{
         private:
-            unsigned int _framebuffer;
-            unsigned int _colorBuffer;
-            unsigned int _depthBuffer;
+            unsigned int _framebuffer = 0;
+            unsigned int _colorBuffer = 0;
+            unsigned int _depthBuffer = 0;
 
-            int _width;
-            int _height;
+            //Multisampled targets draw to renderbuffers and resolve into the sampleable textures above
+            unsigned int _resolveFramebuffer = 0;
+            unsigned int _colorRenderbuffer = 0;
+            unsigned int _depthRenderbuffer = 0;
+
+            int _width = 0;
+            int _height = 0;
+
+            FramebufferDesc _desc;
+            int _samples = 0;
 
             void initialize();
+            void allocateStorage();
+            void release();
 
         public:
             Framebuffer();
             Framebuffer(glm::vec2 resolution);
+            Framebuffer(glm::vec2 resolution, const FramebufferDesc& desc);
             ~Framebuffer();
 
             /// @brief Get the framebuffer ID.
             /// @return Framebuffer ID
             unsigned int GetBufferID();
 
-            /// @brief Get the color buffer ID.
-            /// @return Color buffer ID
+            /// @brief Get the framebuffer ID holding the resolved result, the buffer itself if it isn't multisampled.
+            /// @return Resolved framebuffer ID
+            unsigned int GetResolvedBufferID();
+
+            /// @brief Get the color buffer ID, resolved if the buffer is multisampled.
+            /// @return Color buffer ID, will return 0 if the buffer has no color attachment
             unsigned int GetColorBufferID();
 
-            /// @brief Get the depth buffer ID.
-            /// @return Depth buffer ID
+            /// @brief Get the depth buffer ID, resolved if the buffer is multisampled.
+            /// @return Depth buffer ID, will return 0 if depth can't be sampled
             unsigned int GetDepthBufferID();
 
             /// @brief Get the width of the buffer in pixels.
@@ -61,12 +107,28 @@ namespace GLEP{
             /// @return Height
             int GetHeight();
 
+            /// @brief Get the formats and sample count the buffer was requested with, samples may be clamped to the driver's limit.
+            /// @return Framebuffer descriptor
+            const FramebufferDesc& GetDesc();
+
+            /// @brief Get if the buffer only contains a depth attachment.
+            /// @return If the buffer is depth-only
+            bool GetIsDepthOnly();
+
+            /// @brief Get if the buffer is multisampled and must be resolved before it is sampled.
+            /// @return If the buffer is multisampled
+            bool GetIsMultisampled();
+
+            /// @brief Get the GPU memory used by the buffer's attachments, including resolve targets.
+            /// @return Size in bytes
+            size_t GetAllocatedBytes();
+
 
             /// @brief Set the depth buffer ID.
             /// @param depthTexture Depth buffer ID to set
             void SetDepthBufferID(unsigned int depthBuffer);
 
-            /// @brief Set the resolution of the buffer, re-initializing it
+            /// @brief Set the resolution of the buffer, reallocating the storage of its existing attachments if the size changed.
             /// @param resolution Resolution to set
             void SetResolution(glm::vec2 resolution);
 
@@ -77,6 +139,9 @@ namespace GLEP{
             /// @brief Unbind as the active framebuffer.
             void Unbind();
 
+            /// @brief Resolve a multisampled buffer into its sampleable color and depth textures. Does nothing for single-sampled buffers.
+            void Resolve();
+
             /// @brief Bind the color and depth buffer to a shader uniform.
             void BindResult();
     };
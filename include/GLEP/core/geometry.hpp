@@ -21,9 +21,11 @@
 #include <GLEP/core/utility/file.hpp>
 #include <GLEP/core/utility/print.hpp>
 #include <GLEP/core/utility/math.hpp>
+#include <GLEP/core/utility/deferred_gl.hpp>
 
 #include <vector>
 #include <string>
+#include <atomic>
 #include <sstream>
 
 #include <nlohmann/json.hpp>
@@ -72,18 +74,37 @@ namespace GLEP{
         }
     };
 
+    //Vertices are written to binary scene files as raw memory
+    static_assert(sizeof(Vertex) == 8 * sizeof(float), "Vertex must be tightly packed");
+
+    struct GeometryBlob{
+        const Vertex* Vertices = nullptr;
+        size_t VertexCount = 0;
+        const unsigned int* Indices = nullptr;
+        size_t IndexCount = 0;
+    };
+
     class Geometry{
+        private:
+            static thread_local const std::vector<GeometryBlob>* _blobSource;
+            static std::atomic<unsigned int> _nextBoundsRevision;
+
         protected:
-            unsigned int _VAO;
-            unsigned int _VBO;
-            unsigned int _EBO;
+            unsigned int _VAO = 0;
+            unsigned int _VBO = 0;
+            unsigned int _EBO = 0;
 
             bool _hasInit = false;
 
             std::vector<Vertex> _vertices;
             std::vector<unsigned int> _indices;
 
+            glm::vec3 _boundsMin = glm::vec3(0.0f);
+            glm::vec3 _boundsMax = glm::vec3(0.0f);
+            unsigned int _boundsRevision = 0;
+
             void initialize();
+            void updateBounds();
             void bindVertices();
             void bindIndices();
             
@@ -107,6 +128,7 @@ namespace GLEP{
 
             Geometry();
             Geometry(std::vector<Vertex> vertices, std::vector<unsigned int> indices);
+            Geometry(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount);
             ~Geometry();
 
 
@@ -118,6 +140,26 @@ namespace GLEP{
             /// @return Index data
             std::vector<unsigned int> GetIndices();
 
+            /// @brief Get the amount of vertices without copying them.
+            /// @return Vertex count
+            size_t GetVertexCount();
+
+            /// @brief Get the amount of indices without copying them.
+            /// @return Index count
+            size_t GetIndexCount();
+
+            /// @brief Get the minimum corner of the local space bounding box.
+            /// @return Minimum bounds
+            glm::vec3 GetBoundsMin();
+
+            /// @brief Get the maximum corner of the local space bounding box.
+            /// @return Maximum bounds
+            glm::vec3 GetBoundsMax();
+
+            /// @brief Get a value unique to the current bounds, it changes whenever the vertices are set.
+            /// @return Bounds revision
+            unsigned int GetBoundsRevision();
+
 
             /// @brief Set vertex data, rebinding it.
             /// @param vertices Vertex data to set
@@ -143,6 +185,28 @@ namespace GLEP{
             /// @param data Geometry data in JSON format
             /// @return Deserialized data
             static std::shared_ptr<Geometry> FromJson(const json& data);
+
+            /// @brief Set the blobs that "blob" references in geometry JSON on this thread resolve to, used while loading binary scenes.
+            /// @param blobs Geometry blobs, nullptr to clear
+            static void SetBlobSource(const std::vector<GeometryBlob>* blobs);
+
+            /// @brief Get the blobs that "blob" references in geometry JSON on this thread resolve to.
+            /// @return Geometry blobs, nullptr if not loading a binary scene
+            static const std::vector<GeometryBlob>* GetBlobSource();
+    };
+
+    class GeometryBlobScope{
+        private:
+            const std::vector<GeometryBlob>* _previous;
+
+        public:
+            /// @brief Set the geometry blob source of this thread until the scope ends, restoring the previous one even if loading throws.
+            /// @param blobs Geometry blobs
+            GeometryBlobScope(const std::vector<GeometryBlob>* blobs);
+            ~GeometryBlobScope();
+
+            GeometryBlobScope(const GeometryBlobScope&) = delete;
+            GeometryBlobScope& operator=(const GeometryBlobScope&) = delete;
     };
 
     class ImportGeometry{
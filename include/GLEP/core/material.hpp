@@ -20,6 +20,7 @@
 
 #include <GLEP/core/utility/file.hpp>
 #include <GLEP/core/utility/print.hpp>
+#include <GLEP/core/utility/deferred_gl.hpp>
 
 #include <GLEP/core/framebuffer.hpp>
 #include <GLEP/core/texture.hpp>
@@ -47,6 +48,12 @@ namespace GLEP{
         FRONT_AND_BACK = 0x0408
     };
 
+    enum class ShadowCasterMode{
+        DEPTH_ONLY,
+        ALPHA_TESTED,
+        MATERIAL
+    };
+
     class TypelessShaderUniform {
         protected:
             bool _isPrivate;
@@ -65,19 +72,55 @@ namespace GLEP{
             /// @param material Target material
             virtual void SetUniform(Material* material) = 0;
 
+            /// @brief Bind the uniform's value to a material's shader under a different name.
+            /// @param material Target material
+            /// @param name Uniform name to bind to
+            virtual void SetUniform(Material* material, const std::string& name) = 0;
+
 
             /// @brief Serialize data to JSON format.
             /// @return Serialized data
             virtual json ToJson() = 0;
     };
 
+    class ShaderUniformAlias : public TypelessShaderUniform {
+        public:
+            std::shared_ptr<TypelessShaderUniform> Source;
+
+            ShaderUniformAlias(std::string name, std::shared_ptr<TypelessShaderUniform> source);
+
+
+            /// @brief Bind the source uniform's current value under this uniform's name.
+            /// @param material Target material
+            void SetUniform(Material* material) override;
+
+            /// @brief Bind the source uniform's current value under a different name.
+            /// @param material Target material
+            /// @param name Uniform name to bind to
+            void SetUniform(Material* material, const std::string& name) override;
+
+
+            /// @brief Aliases are private and never serialized.
+            /// @return Empty JSON
+            json ToJson() override;
+    };
+
     class Material{
         protected:
             std::string _name;
             std::shared_ptr<Shader> _shader;
+            std::shared_ptr<Shader> _layeredShader;
+            Shader* _activeShader = nullptr;
+            int _boundCubeMaps = 0;
+            bool _defaultVertexShader = false;
+            std::string _memberName;
 
             std::vector<std::shared_ptr<TypelessShaderUniform>> _uniforms;
 
+            void bind(const std::shared_ptr<Shader>& shader);
+            void setShaderDefaults();
+            const std::string& memberName(const std::string& name, const char* member);
+
         public:
             bool LightingRequired = false;
             bool ReceiveShadows = false;
@@ -85,6 +128,7 @@ namespace GLEP{
             bool BakeRequired = false;
             bool Wireframe = false;
             MaterialCull CullFace = MaterialCull::BACK;
+            ShadowCasterMode ShadowCaster = ShadowCasterMode::DEPTH_ONLY;
 
             Material();
             Material(std::shared_ptr<Material> material, bool copyUniforms = true);
@@ -101,10 +145,22 @@ namespace GLEP{
             /// @return Shader
             std::shared_ptr<Shader> GetShader();
 
+            /// @brief Get if the material's shader uses the built-in vertex stage, so its geometry can be drawn by the renderer's depth shaders.
+            /// @return If the vertex shader is default.vs
+            bool GetHasDefaultVertexShader();
+
+            /// @brief Get the layered cube map variant of the material's shader, building it on first use.
+            /// @return Layered shader, will return nullptr if the material's vertex shader has no layered variant
+            std::shared_ptr<Shader> GetLayeredShader();
+
             /// @brief Get all uniforms assigned to the material.
             /// @return Uniforms
             std::vector<std::shared_ptr<TypelessShaderUniform>> GetUniforms();
 
+            /// @brief Get the first diffuse texture assigned to the material's uniforms.
+            /// @return Diffuse texture, will return nullptr if not found
+            std::shared_ptr<Texture> GetDiffuseTexture();
+
 
             /// @brief Add a uniform to this material.
             /// @tparam T Uniform type
@@ -114,11 +170,15 @@ namespace GLEP{
             template <typename T>
             void AddUniform(const std::string& name, T value, bool isPrivate = false) {
                 std::shared_ptr<ShaderUniform<T>> uniform = std::make_shared<ShaderUniform<T>>(name, value, isPrivate);
-                uniform->SetUniform(this);
+                DeferredGL::Run(this, [this, uniform](){ uniform->SetUniform(this); });
 
                 _uniforms.push_back(uniform);
             }
 
+            /// @brief Add an existing uniform to this material.
+            /// @param uniform Uniform to add
+            void AddUniform(const std::shared_ptr<TypelessShaderUniform>& uniform);
+
 
             /// @brief Get a uniform assigned to this material.
             /// @tparam T Uniform type
@@ -157,6 +217,10 @@ namespace GLEP{
             /// @brief Bind this material's shader and it's assigned uniforms.
             void Use();
 
+            /// @brief Bind this material's layered cube map shader and it's assigned uniforms.
+            /// @return If a layered shader is available for this material
+            bool UseLayered();
+
 
             /// @brief Get the ID of a uniforms location based on its name.
             /// @param name Uniform name
@@ -267,6 +331,13 @@ namespace GLEP{
                 material->SetUniform(Name, Value);
             }
 
+            /// @brief Bind the uniform's value to a material's shader under a different name.
+            /// @param material Target material
+            /// @param name Uniform name to bind to
+            void SetUniform(Material* material, const std::string& name) override{
+                material->SetUniform(name, Value);
+            }
+
 
             /// @brief Serialize data to JSON format.
             /// @return Serialized data
@@ -59,7 +59,16 @@ namespace GLEP{
 
             /// @brief Get the meshes of this model.
             /// @return Meshes
-            std::vector<std::shared_ptr<Mesh>> GetMeshes();
+            const std::vector<std::shared_ptr<Mesh>>& GetMeshes();
+
+            /// @brief Get the bounding box enclosing every mesh in local space.
+            /// @param bounds Resulting bounds
+            /// @return If the model has any meshes
+            bool GetLocalBounds(AABB& bounds) override;
+
+            /// @brief Get a value that changes whenever a mesh's geometry is swapped or its vertices are set.
+            /// @return Bounds revision
+            unsigned int GetBoundsRevision() override;
 
 
             /// @brief Serialize data to JSON format.
@@ -0,0 +1,79 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PROBE_GRID_HPP
+#define PROBE_GRID_HPP
+
+#include <GLEP/core/cube_map.hpp>
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+namespace GLEP {
+
+    class ProbeGrid{
+        private:
+            float _cellSize = 1.0f;
+            glm::ivec3 _minCell = glm::ivec3(0);
+            glm::ivec3 _maxCell = glm::ivec3(0);
+
+            std::vector<BakedCubeMap*> _probes;
+            std::vector<glm::vec3> _positions;
+            std::unordered_map<int64_t, std::vector<int>> _cells;
+
+            glm::ivec3 cellOf(glm::vec3 position);
+            static int64_t cellKey(glm::ivec3 cell);
+
+        public:
+            ProbeGrid();
+
+
+            /// @brief Get the edge length of a grid cell.
+            /// @return Cell size
+            float GetCellSize();
+
+            /// @brief Get the amount of occupied grid cells.
+            /// @return Occupied cell count
+            int GetCellCount();
+
+
+            /// @brief Rebuild the grid from the current probe positions.
+            /// @param probes Probes to index
+            void Build(const std::vector<std::shared_ptr<BakedCubeMap>>& probes);
+
+            /// @brief Check if the probe set has been added to, removed from or moved since the last build.
+            /// @param probes Current probes
+            /// @return If the grid needs to be rebuilt
+            bool IsOutdated(const std::vector<std::shared_ptr<BakedCubeMap>>& probes);
+
+            /// @brief Find the two closest probes to a position.
+            /// @param position Query position
+            /// @param second Index of the second closest probe, -1 if there is only one probe
+            /// @param nearestDistance Distance to the closest probe
+            /// @param secondDistance Distance to the second closest probe
+            /// @return Index of the closest probe, -1 if the grid is empty
+            int FindNearest(glm::vec3 position, int& second, float& nearestDistance, float& secondDistance);
+    };
+
+}
+
+#endif //PROBE_GRID_HPP
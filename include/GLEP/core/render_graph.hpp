@@ -0,0 +1,138 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef RENDER_GRAPH_HPP
+#define RENDER_GRAPH_HPP
+
+#include <GLEP/core/framebuffer.hpp>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace GLEP{
+
+    typedef int RenderGraphResource;
+
+    struct RenderGraphStats{
+        int Passes = 0;
+        int CulledPasses = 0;
+        int TransientResources = 0;
+        int AllocatedTargets = 0;
+        size_t AllocatedBytes = 0;
+    };
+
+    class RenderGraph{
+        public:
+            typedef std::function<void(RenderGraph&)> ExecuteFunc;
+
+        private:
+            struct Resource{
+                std::string Name;
+                glm::vec2 Resolution;
+                FramebufferDesc Desc;
+                bool Imported;
+                std::shared_ptr<Framebuffer> Target;
+                int FirstUse;
+                int LastUse;
+                int PoolIndex;
+            };
+
+            struct Pass{
+                std::string Name;
+                std::vector<RenderGraphResource> Reads;
+                RenderGraphResource Target;
+                ExecuteFunc Execute;
+                bool Culled;
+                bool Resolve;
+            };
+
+            struct PooledTarget{
+                std::shared_ptr<Framebuffer> Target;
+                bool InUse;
+                bool Used;
+            };
+
+            std::vector<Resource> _resources;
+            std::vector<Pass> _passes;
+            std::vector<PooledTarget> _pool;
+
+            bool _compiled = false;
+            RenderGraphStats _stats;
+
+            void cullPasses();
+            void allocateTargets();
+            void resolveTargets();
+            int acquireTarget(glm::vec2 resolution, const FramebufferDesc& desc);
+
+        public:
+            /// @brief Remove all passes and resources. Pooled targets are kept for reuse by the next compile.
+            void Clear();
+
+            /// @brief Declare a transient render target, backed by a pooled framebuffer only while a pass uses it.
+            /// @param name Resource name
+            /// @param resolution Target resolution
+            /// @param desc Attachment formats and sample count, only targets with matching descriptors alias each other
+            /// @return Resource handle
+            RenderGraphResource CreateTarget(const std::string& name, glm::vec2 resolution, const FramebufferDesc& desc = FramebufferDesc());
+
+            /// @brief Declare an externally owned render target. Passes writing to imported targets are never culled.
+            /// @param name Resource name
+            /// @param target Framebuffer to write to (If this is nullptr the default framebuffer is used instead)
+            /// @param resolution Resolution of the default framebuffer, ignored if a target is given
+            /// @return Resource handle
+            RenderGraphResource ImportTarget(const std::string& name, const std::shared_ptr<Framebuffer>& target, glm::vec2 resolution = glm::vec2(0.0f));
+
+            /// @brief Add a pass to the end of the graph.
+            /// @param name Pass name
+            /// @param reads Resources the pass samples or draws on top of
+            /// @param target Resource the pass renders to, bound before the pass is executed
+            /// @param execute Pass render function
+            void AddPass(const std::string& name, const std::vector<RenderGraphResource>& reads, RenderGraphResource target, ExecuteFunc execute);
+
+
+            /// @brief Cull passes that don't contribute to an imported target and assign pooled framebuffers to transient targets, aliasing targets whose lifetimes don't overlap. Multisampled targets are resolved after the last pass drawing to them before they are read.
+            void Compile();
+
+            /// @brief Execute each remaining pass in order, compiling the graph first if required.
+            void Execute();
+
+
+            /// @brief Get the framebuffer assigned to a resource. Transient targets are only assigned once the graph is compiled.
+            /// @param resource Resource handle
+            /// @return Framebuffer, will return nullptr for the default framebuffer
+            const std::shared_ptr<Framebuffer>& GetFramebuffer(RenderGraphResource resource);
+
+            /// @brief Get the resolution of a resource, the viewport is set to it before a pass renders to the resource.
+            /// @param resource Resource handle
+            /// @return Resolution, will be zero for a default framebuffer imported without one
+            glm::vec2 GetResolution(RenderGraphResource resource);
+
+            /// @brief Get the pass and memory statistics of the last compile.
+            /// @return Render graph statistics
+            RenderGraphStats GetStats();
+    };
+
+}
+
+#endif //RENDER_GRAPH_HPP
@@ -20,6 +20,7 @@
 
 #include <GLEP/core/utility/opengl.hpp>
 #include <GLEP/core/utility/print.hpp>
+#include <GLEP/core/utility/allocation_tracker.hpp>
 
 #include <GLEP/core/time.hpp>
 #include <GLEP/core/color.hpp>
@@ -28,14 +29,19 @@
 #include <GLEP/core/mesh.hpp>
 #include <GLEP/core/model.hpp>
 #include <GLEP/core/buffer_pass.hpp>
+#include <GLEP/core/render_graph.hpp>
 #include <GLEP/core/texture.hpp>
 #include <GLEP/core/camera.hpp>
 #include <GLEP/core/cube_map.hpp>
+#include <GLEP/core/frame_capture.hpp>
 #include <GLEP/core/scene.hpp>
 
 #include <memory>
 #include <functional>
 #include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
 
 #include <glad/glad.h>
 #include "GLFW/glfw3.h"
@@ -45,30 +51,186 @@
 
 namespace GLEP {
 
+    enum class ShadowCacheInvalidation{
+        NONE,
+        INITIAL,
+        MANUAL,
+        LIGHT_DIRECTION,
+        SHADOW_MAP_DISTANCE,
+        SHADOW_MAP_CAMERA,
+        STATIC_SET
+    };
+
+    enum class DepthPrePassTest{
+        EQUAL = 0x0202,
+        LEQUAL = 0x0203
+    };
+
+    struct DepthPrePassStats{
+        unsigned int PrePassFragments = 0;
+        unsigned int ShadedFragments = 0;
+        unsigned int FragmentsSaved = 0;
+    };
+
+    struct ProbeUpdateStats{
+        int FacesRendered = 0;
+        int ProbesCompleted = 0;
+        int ProbesPending = 0;
+        float TimeMs = 0.0f;
+    };
+
+    struct RenderScaleStats{
+        float Scale = 1.0f;
+        float GpuTimeMs = 0.0f;
+        glm::vec2 RenderResolution = glm::vec2(0.0f);
+        int ScaleChanges = 0;
+    };
+
+    struct ShadowCacheStats{
+        ShadowCacheInvalidation LastInvalidation = ShadowCacheInvalidation::NONE;
+        int FramesReused = 0;
+        int StaticRenders = 0;
+        int StaticCasters = 0;
+        int DynamicCasters = 0;
+    };
+
     class Renderer{
         protected:
             enum class RenderType{
                 NORMAL,
                 BAKE,
-                SHADOW_MAP
+                SHADOW_MAP_STATIC,
+                SHADOW_MAP_DYNAMIC
+            };
+
+            struct StaticCasterState{
+                SceneObject* Object;
+                glm::mat4 ModelMatrix;
+
+                bool operator==(const StaticCasterState& other) const {
+                    return Object == other.Object && ModelMatrix == other.ModelMatrix;
+                }
+            };
+
+            struct MeshDraw{
+                Mesh* MeshData;
+                glm::mat4 ModelMatrix;
+            };
+
+            struct LayeredDraw{
+                Mesh* MeshData;
+                glm::mat4 ModelMatrix;
+                int FaceMask;
+            };
+
+            struct FrameGraphKey{
+                std::shared_ptr<BufferPassComposer> Composer;
+                unsigned int ComposerRevision = 0;
+                bool FusePasses = false;
+                FramebufferColor ColorFormat = FramebufferColor::RGB8;
+                int Samples = 0;
+                std::shared_ptr<Framebuffer> Output;
+                glm::vec2 OutputResolution = glm::vec2(0.0f);
+                bool Shadows = false;
+                bool Built = false;
             };
 
             bool _isGuiInitalized = false;
             bool _isGuiShutdown = false;
 
             std::shared_ptr<Framebuffer> _shadowMapBuffer;
+            std::shared_ptr<Framebuffer> _staticShadowMapBuffer;
             std::shared_ptr<Camera> _shadowMapCamera;
             glm::mat4 _lightSpaceMatrix = glm::mat4(1.0f);
 
+            bool _shadowCacheValid = false;
+            bool _shadowCacheInvalidated = false;
+            bool _shadowMapHasDynamic = true;
+            glm::vec3 _cachedLightDirection = glm::vec3(0.0f);
+            float _cachedShadowMapDistance = 0.0f;
+            glm::mat4 _cachedShadowProjection = glm::mat4(1.0f);
+            std::vector<StaticCasterState> _cachedStaticCasters;
+            std::vector<StaticCasterState> _staticCasters;
+            ShadowCacheStats _shadowCacheStats;
+
+            std::shared_ptr<Shader> _shadowCasterShader;
+            std::shared_ptr<Shader> _shadowCasterAlphaShader;
+            GLint _shadowCasterModelLoc = -1;
+            GLint _shadowCasterLightSpaceLoc = -1;
+            GLint _shadowCasterAlphaModelLoc = -1;
+            GLint _shadowCasterAlphaLightSpaceLoc = -1;
+            GLint _shadowCasterAlphaTexLoc = -1;
+            std::vector<MeshDraw> _depthCasters;
+            std::vector<MeshDraw> _alphaCasters;
+            std::vector<MeshDraw> _materialCasters;
+
+            std::shared_ptr<Shader> _depthPrePassShader;
+            std::shared_ptr<Shader> _depthPrePassAlphaShader;
+            GLint _depthPrePassModelLoc = -1;
+            GLint _depthPrePassViewLoc = -1;
+            GLint _depthPrePassProjectionLoc = -1;
+            GLint _depthPrePassAlphaModelLoc = -1;
+            GLint _depthPrePassAlphaViewLoc = -1;
+            GLint _depthPrePassAlphaProjectionLoc = -1;
+            GLint _depthPrePassAlphaTexLoc = -1;
+            std::vector<MeshDraw> _prePassDraws;
+            std::vector<MeshDraw> _prePassAlphaDraws;
+            std::vector<MeshDraw> _forwardDraws;
+
+            std::vector<LayeredDraw> _layeredFallbackDraws;
+
+            std::vector<SceneObject*> _visibleObjects;
+
+            struct ProbeUpdate{
+                std::shared_ptr<BakedCubeMap> CubeMap;
+                float Priority;
+            };
+
+            std::vector<ProbeUpdate> _probeQueue;
+            ProbeUpdateStats _probeUpdateStats;
+
+            GLuint _prePassQueries[2][2];
+            bool _prePassQueriesIssued[2] = { false, false };
+            int _prePassQueryFrame = 0;
+            DepthPrePassStats _depthPrePassStats;
+
+            AllocationStats _frameAllocationStats;
+
+            GLuint _frameTimeQueries[3];
+            bool _frameTimeQueriesIssued[3] = { false, false, false };
+            int _frameTimeQueryFrame = 0;
+            int _framesSinceScaleChange = 0;
+            RenderScaleStats _renderScaleStats;
+
+            glm::vec2 _pendingResolution = glm::vec2(0.0f);
+            glm::vec2 _settledResolution = glm::vec2(0.0f);
+            int _resolutionStableFrames = 0;
+
             void initializeDefaults();
             void initializeGui();
 
-            void renderSkybox(std::shared_ptr<Scene> scene, std::shared_ptr<Camera> camera, bool depthTest = true);
-            void renderShadowMap(std::shared_ptr<Scene> scene);
-            void renderSceneObjects(std::shared_ptr<Scene> scene, std::shared_ptr<Camera> camera, RenderType type = RenderType::NORMAL);
-            void renderMesh(std::shared_ptr<Geometry> geo, std::shared_ptr<Material> mat, std::shared_ptr<Scene> scene, glm::vec3 cameraPos, glm::mat4 projection, glm::mat4 view, glm::mat4 model, RenderType type);
-
+            void renderSkybox(const std::shared_ptr<Scene>& scene, const std::shared_ptr<Camera>& camera, bool depthTest = true);
+            void renderShadowMap(const std::shared_ptr<Scene>& scene);
+            void renderShadowCasters(const std::shared_ptr<Scene>& scene, RenderType type);
+            void drawDepthOnly(const MeshDraw& draw, GLint modelLoc, GLenum cullFace);
+            ShadowCacheInvalidation checkShadowCache(const std::shared_ptr<Scene>& scene, glm::vec3 lightDirection);
+            bool isShadowPass(RenderType type);
+            void renderSceneObjects(const std::shared_ptr<Scene>& scene, const std::shared_ptr<Camera>& camera, RenderType type = RenderType::NORMAL);
+            void cullSceneObjects(const std::shared_ptr<Scene>& scene, glm::mat4 projection, glm::mat4 view);
+            bool isCulled(const std::shared_ptr<Scene>& scene, SceneObject* object);
+            void renderWithDepthPrePass(const std::shared_ptr<Scene>& scene, glm::vec3 cameraPos, glm::mat4 projection, glm::mat4 view);
+            void readDepthPrePassQueries(int index);
+            void renderMesh(const std::shared_ptr<Geometry>& geo, const std::shared_ptr<Material>& mat, const std::shared_ptr<Scene>& scene, glm::vec3 cameraPos, glm::mat4 projection, glm::mat4 view, glm::mat4 model, RenderType type);
+            void setMeshUniforms(const std::shared_ptr<Material>& mat, const std::shared_ptr<Scene>& scene, glm::vec3 cameraPos, glm::mat4 projection, glm::mat4 view, glm::mat4 model);
+            void renderLayeredCubeMap(const std::shared_ptr<Scene>& scene, const std::shared_ptr<BakedCubeMap>& cubeMap);
+
+            RenderGraph _frameGraph;
+            FrameGraphKey _frameGraphKey;
+            std::shared_ptr<Scene> _frameScene;
+
+            void updateRenderScale();
             void updateResolution(const std::shared_ptr<BufferPassComposer>& passComposer);
+            void updateFrameGraph(const std::shared_ptr<BufferPassComposer>& passComposer, const std::shared_ptr<Framebuffer>& buffer);
 
         public: 
             std::shared_ptr<Window> TargetWindow;
@@ -81,6 +243,29 @@ namespace GLEP {
             float ShadowMapDistance = 2.0f;
             bool RenderShadows = true;
 
+            bool FrustumCulling = true;
+            bool LayeredBake = true;
+            int ProbeFaceBudget = 1;
+            float ProbeTimeBudget = 0.0f;
+
+            bool DepthPrePass = false;
+            DepthPrePassTest PrePassDepthTest = DepthPrePassTest::LEQUAL;
+
+            bool ReportFrameAllocations = false;
+
+            float RenderScale = 1.0f;
+            bool DynamicResolution = false;
+            float MinRenderScale = 0.5f;
+            float MaxRenderScale = 1.0f;
+            float RenderScaleStep = 0.05f;
+            float TargetFrameTime = 16.0f;
+            float FrameTimeHysteresis = 0.1f;
+            int RenderScaleCooldown = 30;
+
+            int ResizeDebounceFrames = 6;
+
+            std::shared_ptr<FrameCapture> Capture;
+
             Renderer(std::shared_ptr<Window> window);
             Renderer(std::shared_ptr<Window> window, std::shared_ptr<Camera> camera);
             ~Renderer();
@@ -98,6 +283,40 @@ namespace GLEP {
             /// @return Shadow map buffer
             std::shared_ptr<Framebuffer> GetShadowMapBuffer();
 
+            /// @brief Get the buffer caching the shadow map of static casters.
+            /// @return Static shadow map buffer
+            std::shared_ptr<Framebuffer> GetStaticShadowMapBuffer();
+
+            /// @brief Get the reuse statistics of the static shadow map cache.
+            /// @return Shadow cache statistics
+            ShadowCacheStats GetShadowCacheStats();
+
+            /// @brief Get the work done by the probe scheduler during the last frame.
+            /// @return Probe update statistics
+            ProbeUpdateStats GetProbeUpdateStats();
+
+
+            /// @brief Get the fragment counts of the last completed depth pre-pass frame.
+            /// @return Depth pre-pass statistics
+            DepthPrePassStats GetDepthPrePassStats();
+
+            /// @brief Get the heap allocations made by the last Render call, excluding the GUI callback. Only counted when built with GLEP_TRACK_ALLOCATIONS.
+            /// @return Frame allocation statistics
+            AllocationStats GetFrameAllocationStats();
+
+
+            /// @brief Get the current render scale and the GPU frame time it is adapted to.
+            /// @return Render scale statistics
+            RenderScaleStats GetRenderScaleStats();
+
+            /// @brief Get the pass and transient target statistics of the frame's render graph.
+            /// @return Render graph statistics
+            RenderGraphStats GetFrameGraphStats();
+
+
+            /// @brief Force the static shadow map layer to be re-rendered on the next frame.
+            void InvalidateShadowCache();
+
 
             /// @brief Convert a screen-space point to a world-space point using the target camera.
             /// @param screenPos Screen-space point
@@ -129,6 +348,11 @@ namespace GLEP {
             /// @param scene Target scene
             void Bake(std::shared_ptr<Scene> scene);
 
+            /// @brief Re-render pending baked cube map faces, highest priority first, until the per-frame face or time budget is spent.
+            /// @param scene Target scene
+            /// @param camera Camera used to prioritise probes by distance and screen coverage
+            void UpdateProbes(std::shared_ptr<Scene> scene, std::shared_ptr<Camera> camera);
+
             /// @brief Render a scene to either the target window or a framebuffer.
             /// @param scene Target scene
             /// @param buffer Target framebuffer (If this is nullptr the scene will be rendered to the target window instead).
@@ -24,9 +24,20 @@
 #include <GLEP/core/mesh.hpp>
 #include <GLEP/core/model.hpp>
 #include <GLEP/core/cube_map.hpp>
+#include <GLEP/core/probe_grid.hpp>
+#include <GLEP/core/bvh.hpp>
+#include <GLEP/core/transform_hierarchy.hpp>
+#include <GLEP/core/component_store.hpp>
+#include <GLEP/core/scene_binary.hpp>
+#include <GLEP/core/world_partition.hpp>
+
+#include <GLEP/core/utility/json_stream.hpp>
 
 #include <vector>
+#include <unordered_map>
 #include <filesystem>
+#include <istream>
+#include <ostream>
 
 #include <nlohmann/json.hpp>
 #include <glm/glm.hpp>
@@ -42,6 +53,14 @@ namespace GLEP {
         int SpotLightsAmt = 0;
     };
 
+    struct ProbeAssignment{
+        glm::vec3 Position = glm::vec3(0.0f);
+        int Primary = -1;
+        int Secondary = -1;
+        float Blend = 0.0f;
+        std::vector<Material*> Materials;
+    };
+
     class Scene{
         private:
             SceneLightData _lightData;
@@ -50,11 +69,40 @@ namespace GLEP {
             std::vector<std::shared_ptr<SceneObject>> _objects;
             std::vector<std::shared_ptr<Light>> _lights;
 
-            std::shared_ptr<CubeMap> findClosestCubeMap(glm::vec3 position);
+            std::vector<std::shared_ptr<Model>> _models;
+            std::vector<std::shared_ptr<SceneObject>> _componentObjects;
+            std::vector<std::shared_ptr<Light>> _lightsByType[4];
+            std::shared_ptr<DirectionalLight> _directionalLight;
+
+            std::unordered_map<std::string, std::vector<std::shared_ptr<SceneObject>>> _nameIndex;
+            std::unordered_map<std::string, std::vector<std::shared_ptr<SceneObject>>> _tagIndex;
+
+            SceneBVH _bvh;
+            TransformHierarchy _transforms;
+            ComponentStore _componentStore;
+
+            ProbeGrid _probeGrid;
+            std::unordered_map<SceneObject*, ProbeAssignment> _probeAssignments;
+            bool _assignedBlendProbes = false;
+
+            void assignProbe(std::shared_ptr<Model> model, ProbeAssignment& assignment);
+            bool materialsChanged(Model* model, const ProbeAssignment& assignment);
+
+            void indexObject(const std::shared_ptr<SceneObject>& object);
+            void unindexObject(SceneObject* object);
+            static void removeFromIndex(std::unordered_map<std::string, std::vector<std::shared_ptr<SceneObject>>>& index, const std::string& key, SceneObject* object);
+
+            static unsigned int loadThreadCount(int objectCount);
+            static void addObjects(Scene& scene, const std::vector<const json*>& objectsData);
 
         public:
             std::shared_ptr<BufferPassComposer> PassComposer;
             std::shared_ptr<Mesh> Skybox;
+            bool BlendProbes = false;
+            std::shared_ptr<WorldPartition> Partition;
+
+            /// @brief Threads used to deserialize scene objects, 0 uses every hardware thread and 1 loads sequentially.
+            static unsigned int LoadThreads;
 
             Scene();
             ~Scene();
@@ -81,9 +129,22 @@ namespace GLEP {
             /// @return Found light, will return nullptr if not valid
             std::shared_ptr<Light> GetLight(int index);
 
+            /// @brief Get all the models in the scene, kept up to date on Add and Remove.
+            /// @return Models
+            const std::vector<std::shared_ptr<Model>>& GetModels();
+
+            /// @brief Get all the objects in the scene that have components, kept up to date as components are added.
+            /// @return Objects with components
+            const std::vector<std::shared_ptr<SceneObject>>& GetObjectsWithComponents();
+
+            /// @brief Get all the lights of a type in the scene.
+            /// @param type Light type
+            /// @return Lights
+            const std::vector<std::shared_ptr<Light>>& GetLightsByType(LightType type);
+
             /// @brief Get the directional light of the scene.
             /// @return Directional light, will return nullptr if no directional light has been assigned.
-            std::shared_ptr<DirectionalLight> GetDirectionalLight();
+            const std::shared_ptr<DirectionalLight>& GetDirectionalLight();
 
             /// @brief Get all the baked cube maps currently in the scene.
             /// @return Baked cube maps
@@ -119,12 +180,42 @@ namespace GLEP {
             /// @param cubeMap Baked cube map to add
             void Add(std::shared_ptr<BakedCubeMap> cubeMap);
 
-            /// @brief Call each objects update function.
+            /// @brief Move an object to its current name and tag in the index (Called by SceneObject).
+            /// @param object Renamed object
+            /// @param oldName Name the object was indexed under
+            /// @param oldTag Tag the object was indexed under
+            void Reindex(const std::shared_ptr<SceneObject>& object, const std::string& oldName, const std::string& oldTag);
+
+            /// @brief Track an object that gained its first component so it is updated (Called by SceneObject).
+            /// @param object Object with components
+            void AddComponentObject(const std::shared_ptr<SceneObject>& object);
+
+            /// @brief Call each objects update function and refit the bounding volume hierarchy around objects that moved.
             void UpdateObjects();
 
+            /// @brief Get the bounding volume hierarchy of the scene's objects.
+            /// @return Scene BVH
+            SceneBVH& GetBVH();
+
+            /// @brief Get the contiguous component storage used by the scene's objects.
+            /// @return Component store
+            ComponentStore& GetComponentStore();
+
+            /// @brief Rebuild the bounding volume hierarchy from scratch, useful after many objects have been added.
+            void RebuildBVH();
+
             /// @brief Assign baked cube maps to materials that require them based on their position.
+            /// Only objects that moved since their last assignment are updated, unless the probes themselves changed.
             void UpdateBake();
 
+            /// @brief Force every object to be reassigned on the next UpdateBake().
+            void InvalidateProbeAssignments();
+
+            /// @brief Get the cached probe assignment of an object.
+            /// @param object Target object
+            /// @return Probe assignment, will return nullptr if the object hasn't been assigned
+            const ProbeAssignment* GetProbeAssignment(SceneObject* object);
+
 
             /// @brief Find an object by its name.
             /// @param name Object name
@@ -136,6 +227,16 @@ namespace GLEP {
             /// @return Found objects
             std::vector<std::shared_ptr<SceneObject>> FindObjectsByName(std::string name);
 
+            /// @brief Find an object by its tag.
+            /// @param tag Object tag
+            /// @return Found object, will return nullptr if not found
+            std::shared_ptr<SceneObject> FindObjectByTag(std::string tag);
+
+            /// @brief Find all objects with a given tag.
+            /// @param tag Object tag
+            /// @return Found objects
+            std::vector<std::shared_ptr<SceneObject>> FindObjectsByTag(std::string tag);
+
 
             /// @brief Find an item in the scene by its type.
             /// @tparam T Item type
@@ -193,15 +294,32 @@ namespace GLEP {
             /// @return Serialized data
             json ToJson();
 
+            /// @brief Serialize to JSON format straight into a stream, one object at a time, matching ToJson's layout.
+            /// @param stream Stream to write to
+            /// @param indent Spaces per indentation level
+            void WriteJson(std::ostream& stream, unsigned int indent = 2);
+
+            /// @brief Deserialize a single scene object, or model, from the scene's JSON format.
+            /// @param data Object data in JSON format
+            /// @return Deserialized object
+            static std::shared_ptr<SceneObject> ObjectFromJson(const json& data);
+
             /// @brief Deserialize data from JSON format.
             /// @param data Scene data in JSON format
             /// @return Deserialized Scene
             static std::shared_ptr<Scene> FromJson(const json& data);
 
-            /// @brief Import scene data from a JSON file.
-            /// @param filePath JSON file path
+            /// @brief Deserialize a JSON stream, building each object as it is parsed rather than parsing the whole document first.
+            /// @param stream Stream of scene data in JSON format
+            /// @param stats Optional load statistics to fill with read and build times
+            /// @return Deserialized Scene, nullptr if the stream could not be parsed
+            static std::shared_ptr<Scene> FromJsonStream(std::istream& stream, SceneLoadStats* stats = nullptr);
+
+            /// @brief Import scene data from a JSON file, or a binary scene file with the SceneBinary::EXTENSION extension.
+            /// @param filePath JSON or binary scene file path
+            /// @param stats Optional load statistics to fill
             /// @return Deserialized Scene
-            static std::shared_ptr<Scene> ImportFromFile(std::filesystem::path filePath);
+            static std::shared_ptr<Scene> ImportFromFile(std::filesystem::path filePath, SceneLoadStats* stats = nullptr);
     };
     
 }
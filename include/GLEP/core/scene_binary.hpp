@@ -0,0 +1,110 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SCENE_BINARY_HPP
+#define SCENE_BINARY_HPP
+
+#include <GLEP/core/utility/print.hpp>
+#include <GLEP/core/utility/mapped_file.hpp>
+#include <GLEP/core/geometry.hpp>
+#include <GLEP/core/utility/allocation_tracker.hpp>
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <filesystem>
+
+#include <nlohmann/json.hpp>
+
+namespace GLEP {
+
+    using json = nlohmann::ordered_json;
+
+    class Scene;
+
+    struct SceneLoadStats{
+        std::string Format;
+        size_t FileBytes = 0;
+        size_t BlobBytes = 0;
+        int GeometryBlobs = 0;
+        double ReadTimeMs = 0.0;
+        double BuildTimeMs = 0.0;
+        //Process-wide and never decreases, compare formats in separate runs
+        size_t PeakResidentBytes = 0;
+    };
+
+    class SceneBinary{
+        private:
+            struct Header{
+                char Magic[4];
+                uint32_t Version;
+                uint32_t BlobCount;
+                uint32_t Reserved;
+                uint64_t BlobTableOffset;
+                uint64_t TableOffset;
+                uint64_t TableSize;
+            };
+
+            struct BlobEntry{
+                uint64_t VertexOffset;
+                uint64_t VertexCount;
+                uint64_t IndexOffset;
+                uint64_t IndexCount;
+            };
+
+            static const size_t BLOB_ALIGNMENT = 16;
+
+            static void extractBlobs(json& data, std::ofstream& out, std::vector<BlobEntry>& entries);
+            static void expandBlobs(json& data, const std::vector<GeometryBlob>& blobs);
+
+        public:
+            static const uint32_t VERSION = 1;
+
+            /// @brief File extension used for binary scenes.
+            static const std::string EXTENSION;
+
+
+            /// @brief Write scene data to a binary file, moving raw geometry into aligned blobs and the rest into a CBOR table.
+            /// @param filePath File path to write to
+            /// @param data Scene data in JSON format, as produced by Scene::ToJson(). Taken by value so geometry is extracted in place, move it in to avoid a copy
+            /// @return If the file was written successfully
+            static bool Write(std::filesystem::path filePath, json data);
+
+            /// @brief Map a binary scene file and create a scene from it, copying geometry straight out of the mapping.
+            /// @param filePath Binary scene file path
+            /// @param stats Optional load statistics to fill
+            /// @return Deserialized Scene, will return nullptr if the file is invalid
+            static std::shared_ptr<Scene> Load(std::filesystem::path filePath, SceneLoadStats* stats = nullptr);
+
+            /// @brief Decode the table of a mapped binary scene file and resolve its geometry blobs.
+            /// @param file Mapped binary scene file, must stay open while the blobs are used
+            /// @param table Output table in JSON format, geometry refers to blobs by index
+            /// @param blobs Output geometry blobs pointing into the mapping
+            /// @return If the file is a valid binary scene
+            static bool Read(MappedFile& file, json& table, std::vector<GeometryBlob>& blobs);
+
+            /// @brief Convert a binary scene file back to the JSON scene format.
+            /// @param filePath Binary scene file path
+            /// @return Scene data in JSON format, will return null if the file is invalid
+            static json ToJson(std::filesystem::path filePath);
+    };
+
+}
+
+#endif //SCENE_BINARY_HPP
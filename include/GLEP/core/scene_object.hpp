@@ -38,26 +38,52 @@ namespace GLEP {
     using json = nlohmann::ordered_json;
 
     class ObjectComponent;
+    class TransformHierarchy;
+    class ComponentStore;
+    class Scene;
     
     class SceneObject : public std::enable_shared_from_this<SceneObject>{       
         protected:
             bool _firstUpdate = true;
 
+            std::string _name = "Object";
+            std::string _tag = "";
+
             glm::mat4 _modelMatrix;
 
             glm::vec3 _worldPosition;
             glm::quat _worldRotation;
             glm::vec3 _worldScale;
 
+            glm::vec3 _localPosition;
+            glm::quat _localRotation;
+            glm::vec3 _localScale;
+            unsigned int _transformRevision = 0;
+            SceneObject* _transformParent = nullptr;
+            unsigned int _parentRevision = 0;
+
+            TransformHierarchy* _transformHierarchy = nullptr;
+            ComponentStore* _componentStore = nullptr;
+            Scene* _scene = nullptr;
+
             std::vector<std::shared_ptr<SceneObject>> _children;
             std::vector<std::unique_ptr<ObjectComponent>> _components;
 
             void updateModelMatrix();
+            bool hasLocalChanged();
+            void refreshTransform();
+            void ensureTransform();
+            void setWorldTransform(glm::vec3 position, glm::quat rotation, glm::vec3 scale);
+
+            friend class TransformHierarchy;
+            friend class ComponentStore;
+            friend class Scene;
 
         public:
-            std::string Name = "Object";
             std::shared_ptr<SceneObject> Parent;
 
+            bool IsStatic = false;
+
             glm::vec3 Position;
             glm::quat Rotation;
             glm::vec3 Scale;
@@ -65,11 +91,23 @@ namespace GLEP {
             SceneObject();
             virtual ~SceneObject() = default;
 
-            /// @brief Get the model matrix.
+            /// @brief Get the name of this object.
+            /// @return Name
+            std::string GetName();
+
+            /// @brief Get the tag of this object.
+            /// @return Tag
+            std::string GetTag();
+
+            /// @brief Get the cached model matrix, recalculated only when the transform changes. Objects in a scene return the transform from its last UpdateObjects().
             /// @return Model matrix
             glm::mat4 GetModelMatrix();
 
-            /// @brief Get the world postion.
+            /// @brief Get a counter that increases every time the world transform is recalculated.
+            /// @return Transform revision
+            unsigned int GetTransformRevision();
+
+            /// @brief Get the world postion, as of the scene's last UpdateObjects() for objects in a scene.
             /// @return World position
             glm::vec3 GetWorldPosition();
 
@@ -81,6 +119,15 @@ namespace GLEP {
             /// @return World scale
             glm::vec3 GetWorldScale();
 
+            /// @brief Get the bounding box of this object in local space.
+            /// @param bounds Resulting bounds
+            /// @return If the object has any bounds
+            virtual bool GetLocalBounds(AABB& bounds);
+
+            /// @brief Get a value that changes whenever the local bounds change.
+            /// @return Bounds revision
+            virtual unsigned int GetBoundsRevision();
+
             /// @brief Get all children assigned to this object.
             /// @return Children objects
             std::vector<std::shared_ptr<SceneObject>>& GetChildren();
@@ -90,6 +137,15 @@ namespace GLEP {
             std::vector<std::unique_ptr<ObjectComponent>>& GetComponents();
 
 
+            /// @brief Set the name of this object, updating the scene's name index.
+            /// @param name Name to set
+            void SetName(std::string name);
+
+            /// @brief Set the tag of this object, updating the scene's tag index.
+            /// @param tag Tag to set
+            void SetTag(std::string tag);
+
+
             /// @brief Make an object the child of this object.
             /// @param object Child to add
             void Add(std::shared_ptr<SceneObject> object);
@@ -102,7 +158,7 @@ namespace GLEP {
             /// @brief Trigger each components' update function and update this object's world transform.
             void Update();
 
-            /// @brief Update this object's world transform.
+            /// @brief Force this object's world transform, and its parents', to be recalculated immediately.
             void UpdateTransformVectors();
 
             /// @brief Find the first matching component by its type.
@@ -119,6 +175,24 @@ namespace GLEP {
                 return nullptr;
             }
 
+            /// @brief Add a component to the scene's contiguous storage, where it is updated by its type's system. Requires component_store.hpp.
+            /// @tparam T Component type
+            /// @param args Component constructor arguments
+            /// @return Stored component, valid until a component of this type is added or removed, or nullptr if not in a scene
+            template <typename T, typename... Args>
+            T* AddStoredComponent(Args&&... args);
+
+            /// @brief Find this object's component of a type in the scene's contiguous storage. Requires component_store.hpp.
+            /// @tparam T Component type
+            /// @return Found component, will return nullptr if not found
+            template <typename T>
+            T* GetStoredComponent();
+
+            /// @brief Remove this object's component of a type from the scene's contiguous storage. Requires component_store.hpp.
+            /// @tparam T Component type
+            template <typename T>
+            void RemoveStoredComponent();
+
             /// @brief Find all matching components by their type.
             /// @tparam T Component type
             /// @return Found components
@@ -19,6 +19,7 @@
 #define SHADER_HPP
 
 #include <GLEP/core/utility/print.hpp>
+#include <GLEP/core/utility/deferred_gl.hpp>
 
 #include <filesystem>
 #include <memory>
@@ -36,19 +37,23 @@ namespace GLEP {
         private:
             std::filesystem::path _vsFilePath;
             std::filesystem::path _fsFilePath;
+            std::filesystem::path _gsFilePath;
             std::string _vsSrc;
             std::string _fsSrc;
+            std::string _gsSrc;
 
-            unsigned int _ID;
+            unsigned int _ID = 0;
 
             bool checkCompileErrors(unsigned int shader, std::string type);
             bool readFiles();
+            bool compile();
 
             bool initialize();
 
         public:
             Shader();
             Shader(std::filesystem::path vsFilePath, std::filesystem::path fsFilePath);
+            Shader(std::filesystem::path vsFilePath, std::filesystem::path gsFilePath, std::filesystem::path fsFilePath);
             ~Shader();
 
             /// @brief Get the shader program ID.
@@ -63,6 +68,26 @@ namespace GLEP {
             /// @return Fragment shader file path
             std::filesystem::path GetFsPath();
 
+            /// @brief Get the file path of the geometry shader.
+            /// @return Geometry shader file path, will be empty if the program has no geometry stage
+            std::filesystem::path GetGsPath();
+
+            /// @brief Get the source code of the vertex shader.
+            /// @return Vertex shader source
+            const std::string& GetVsSource();
+
+            /// @brief Get the source code of the fragment shader.
+            /// @return Fragment shader source
+            const std::string& GetFsSource();
+
+
+            /// @brief Create a shader program from source code instead of files.
+            /// @param vsSource Vertex shader source
+            /// @param fsSource Fragment shader source
+            /// @param name Name reported in place of a file path by compile errors
+            /// @return Shader
+            static std::shared_ptr<Shader> FromSource(const std::string& vsSource, const std::string& fsSource, const std::string& name);
+
 
             /// @brief Set as the active shader program.
             void Use();
@@ -20,6 +20,7 @@
 
 #include <GLEP/core/utility/file.hpp>
 #include <GLEP/core/utility/print.hpp>
+#include <GLEP/core/utility/deferred_gl.hpp>
 
 #include <GLEP/core/color.hpp>
 
@@ -60,7 +61,7 @@ namespace GLEP{
 
     class Texture{
         private:
-            unsigned int _ID;
+            unsigned int _ID = 0;
             int _width;
             int _height;
             int _nrChannels;
@@ -0,0 +1,74 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TRANSFORM_HIERARCHY_HPP
+#define TRANSFORM_HIERARCHY_HPP
+
+#include <GLEP/core/scene_object.hpp>
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+namespace GLEP {
+
+    class TransformHierarchy{
+        private:
+            static const int EXTERNAL_PARENT = -2;
+
+            std::vector<SceneObject*> _objects;
+            std::vector<int> _parents;
+            std::unordered_map<SceneObject*, int> _indices;
+
+            bool _needsRebuild = true;
+
+            void addRecursive(SceneObject* object, int parent);
+
+        public:
+            TransformHierarchy();
+
+
+            /// @brief Get the amount of objects in the hierarchy, including children.
+            /// @return Object count
+            int GetCount();
+
+
+            /// @brief Force the object order to be rebuilt on the next update.
+            void Invalidate();
+
+            /// @brief Assign an object and its children to this hierarchy, so children added to them later rebuild it (Called by Scene).
+            /// @param object Object to assign
+            void Attach(SceneObject* object);
+
+            /// @brief Unassign an object and its children from this hierarchy (Called by Scene).
+            /// @param object Object to unassign
+            void Detach(SceneObject* object);
+
+            /// @brief Flatten scene objects and their children so every parent comes before its children.
+            /// @param objects Top level scene objects
+            void Rebuild(const std::vector<std::shared_ptr<SceneObject>>& objects);
+
+            /// @brief Recalculate world transforms in a single linear pass, only for objects whose local transform or parent changed.
+            /// @param objects Top level scene objects
+            /// @return Amount of world transforms recalculated
+            int Update(const std::vector<std::shared_ptr<SceneObject>>& objects);
+    };
+
+}
+
+#endif //TRANSFORM_HIERARCHY_HPP
@@ -0,0 +1,52 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ALLOCATION_TRACKER_HPP
+#define ALLOCATION_TRACKER_HPP
+
+#include <cstddef>
+
+namespace GLEP{
+
+    struct AllocationStats{
+        size_t Allocations = 0;
+        size_t Bytes = 0;
+    };
+
+    class AllocationTracker{
+        public:
+            /// @brief Get if allocation tracking was compiled in, which replaces the global operator new when GLEP_TRACK_ALLOCATIONS is defined.
+            /// @return If allocations are being counted
+            static bool IsEnabled();
+
+            /// @brief Get the heap allocations made on the calling thread so far, always empty when tracking is disabled.
+            /// @return Allocation count and total bytes requested
+            static AllocationStats GetThreadStats();
+
+            /// @brief Get the most memory the process has had resident at once, this never decreases. Works without allocation tracking.
+            /// @return Peak resident bytes, or 0 if the platform can't report it
+            static size_t GetPeakResidentBytes();
+
+            /// @brief Count an allocation against the calling thread.
+            /// @param bytes Bytes requested
+            static void Record(size_t bytes);
+    };
+
+}
+
+#endif //ALLOCATION_TRACKER_HPP
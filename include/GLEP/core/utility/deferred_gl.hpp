@@ -0,0 +1,67 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DEFERRED_GL_HPP
+#define DEFERRED_GL_HPP
+
+#include <vector>
+#include <functional>
+
+namespace GLEP{
+
+    struct DeferredGLTask{
+        const void* Owner;
+        std::function<void()> Function;
+    };
+
+    typedef std::vector<DeferredGLTask> DeferredGLTaskList;
+
+    class DeferredGL{
+        private:
+            static thread_local DeferredGLTaskList* _recording;
+
+        public:
+            /// @brief Record GL work issued on this thread into a list instead of running it, used by threads without a GL context.
+            /// @param tasks List to record into
+            static void Begin(DeferredGLTaskList* tasks);
+
+            /// @brief Stop recording GL work on this thread.
+            static void End();
+
+            /// @brief Get if GL work on this thread is being recorded.
+            /// @return If recording
+            static bool IsRecording();
+
+
+            /// @brief Run GL work immediately, or record it if this thread is recording.
+            /// @param owner Object the work belongs to, used to cancel it
+            /// @param task GL work
+            static void Run(const void* owner, std::function<void()> task);
+
+            /// @brief Drop recorded work of an object destroyed before the work was executed.
+            /// @param owner Object the work belongs to
+            static void Cancel(const void* owner);
+
+            /// @brief Execute recorded work in the order it was recorded, must be called on the GL context thread.
+            /// @param tasks Recorded work
+            static void Execute(DeferredGLTaskList& tasks);
+    };
+
+}
+
+#endif //DEFERRED_GL_HPP
@@ -42,6 +42,12 @@ namespace GLEP{
             /// @return If the exporting process was a success
             static bool SceneToFile(std::filesystem::path targetPath, const std::shared_ptr<Scene>& scene);
 
+            /// @brief Export a scene to a binary scene file, which loads without parsing vertex data.
+            /// @param targetPath File path to write to
+            /// @param scene Scene to write to a binary file
+            /// @return If the exporting process was a success
+            static bool SceneToBinaryFile(std::filesystem::path targetPath, const std::shared_ptr<Scene>& scene);
+
             /// @brief Export a framebuffer's color buffer to a JPG file.
             /// @param targetPath File path to write to 
             /// @param framebuffer Buffer to read from
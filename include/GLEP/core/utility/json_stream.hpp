@@ -0,0 +1,129 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef JSON_STREAM_HPP
+#define JSON_STREAM_HPP
+
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace GLEP{
+
+    using json = nlohmann::ordered_json;
+
+    class JsonStreamWriter{
+        private:
+            std::ostream& _stream;
+            unsigned int _indent;
+            std::vector<bool> _empty;
+
+            void separate(const std::string* key);
+            void begin(const std::string* key, char open);
+            void end(char close);
+            void write(const std::string* key, const json& value);
+
+        public:
+            JsonStreamWriter(std::ostream& stream, unsigned int indent = 2);
+
+
+            /// @brief Open an object at the root or as an array element.
+            void BeginObject();
+
+            /// @brief Open an object as a member of the current object.
+            /// @param key Member name
+            void BeginObject(const std::string& key);
+
+            /// @brief Close the innermost object.
+            void EndObject();
+
+            /// @brief Open an array at the root or as an array element.
+            void BeginArray();
+
+            /// @brief Open an array as a member of the current object.
+            /// @param key Member name
+            void BeginArray(const std::string& key);
+
+            /// @brief Close the innermost array.
+            void EndArray();
+
+            /// @brief Write a complete value straight to the stream as an array element.
+            /// @param value Value to write
+            void Value(const json& value);
+
+            /// @brief Write a complete value straight to the stream as a member of the current object.
+            /// @param key Member name
+            /// @param value Value to write
+            void Value(const std::string& key, const json& value);
+    };
+
+    class JsonStreamReader : public json::json_sax_t{
+        public:
+            /// @brief Receives the key of a root member and a complete value, returning false stops parsing.
+            typedef std::function<bool(const std::string& key, json& value)> Callback;
+
+        private:
+            Callback _onElement;
+            Callback _onValue;
+
+            int _depth = 0;
+            bool _inArray = false;
+            std::string _key;
+
+            json _value;
+            std::vector<json*> _stack;
+            json* _member = nullptr;
+
+            bool value(json&& value);
+            bool open(json&& container);
+            bool close();
+            bool deliver();
+
+        public:
+            /// @param onElement Called with each element of an array member of the root object
+            /// @param onValue Called with every other member of the root object
+            JsonStreamReader(Callback onElement, Callback onValue);
+
+
+            /// @brief Parse a stream whose root is an object, handing over one member or array element at a time.
+            /// @param stream Stream to parse
+            /// @return If the stream was parsed completely
+            bool Parse(std::istream& stream);
+
+            bool null() override;
+            bool boolean(bool val) override;
+            bool number_integer(number_integer_t val) override;
+            bool number_unsigned(number_unsigned_t val) override;
+            bool number_float(number_float_t val, const string_t& s) override;
+            bool string(string_t& val) override;
+            bool binary(binary_t& val) override;
+            bool start_object(std::size_t elements) override;
+            bool key(string_t& val) override;
+            bool end_object() override;
+            bool start_array(std::size_t elements) override;
+            bool end_array() override;
+            bool parse_error(std::size_t position, const std::string& last_token, const nlohmann::detail::exception& ex) override;
+    };
+
+}
+
+#endif //JSON_STREAM_HPP
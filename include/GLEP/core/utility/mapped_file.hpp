@@ -0,0 +1,67 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <filesystem>
+#include <cstddef>
+
+namespace GLEP{
+
+    class MappedFile{
+        private:
+            const unsigned char* _data = nullptr;
+            size_t _size = 0;
+
+            #ifdef _WIN32
+            void* _fileHandle = nullptr;
+            void* _mappingHandle = nullptr;
+            #else
+            int _fileDescriptor = -1;
+            #endif
+
+        public:
+            MappedFile();
+            ~MappedFile();
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+
+            /// @brief Map a file into memory as read only, closing any previously mapped file.
+            /// @param filePath File to map
+            /// @return If the file was mapped successfully
+            bool Open(std::filesystem::path filePath);
+
+            /// @brief Unmap the file, invalidating any pointers into it.
+            void Close();
+
+
+            /// @brief Get the start of the mapped file.
+            /// @return Mapped data, nullptr if no file is mapped
+            const unsigned char* GetData();
+
+            /// @brief Get the size of the mapped file in bytes.
+            /// @return File size
+            size_t GetSize();
+    };
+
+}
+
+#endif //MAPPED_FILE_HPP
@@ -19,6 +19,7 @@
 #define MATH_HPP
 
 #include <algorithm>
+#include <cfloat>
 
 #include <nlohmann/json.hpp>
 #include <glm/glm.hpp>
@@ -41,6 +42,87 @@ namespace GLEP{
         EASE_IN_OUT_CUBIC
     };
 
+    struct AABB{
+        glm::vec3 Min = glm::vec3(FLT_MAX);
+        glm::vec3 Max = glm::vec3(-FLT_MAX);
+
+        AABB();
+        AABB(glm::vec3 min, glm::vec3 max);
+
+        /// @brief Check if the box encloses at least a single point.
+        /// @return If the box is valid
+        bool IsValid() const;
+
+        /// @brief Get the center of the box.
+        /// @return Center
+        glm::vec3 GetCenter() const;
+
+        /// @brief Get the surface area of the box.
+        /// @return Surface area
+        float GetSurfaceArea() const;
+
+        /// @brief Grow the box to enclose a point.
+        /// @param point Point to enclose
+        void Expand(glm::vec3 point);
+
+        /// @brief Grow the box to enclose another box.
+        /// @param other Box to enclose
+        void Expand(const AABB& other);
+
+        /// @brief Get the box enclosing this box after a transformation.
+        /// @param transform Transform to apply
+        /// @return Transformed box
+        AABB Transform(const glm::mat4& transform) const;
+
+        /// @brief Check if another box overlaps this box.
+        /// @param other Box to check
+        /// @return If the boxes intersect
+        bool Intersects(const AABB& other) const;
+
+        /// @brief Check if a sphere overlaps this box.
+        /// @param center Sphere center
+        /// @param radius Sphere radius
+        /// @return If the sphere intersects
+        bool IntersectsSphere(glm::vec3 center, float radius) const;
+
+        /// @brief Check if a ray hits this box.
+        /// @param origin Ray origin
+        /// @param inverseDirection Component-wise inverse of the ray direction
+        /// @param maxDistance Maximum distance along the ray
+        /// @param distance Distance along the ray where the box is entered
+        /// @return If the ray hits the box
+        bool IntersectsRay(glm::vec3 origin, glm::vec3 inverseDirection, float maxDistance, float& distance) const;
+
+        bool operator==(const AABB& other) const { return Min == other.Min && Max == other.Max; }
+        bool operator!=(const AABB& other) const { return !(*this == other); }
+
+        /// @brief Get the box enclosing two boxes.
+        /// @param a First box
+        /// @param b Second box
+        /// @return Enclosing box
+        static AABB Union(const AABB& a, const AABB& b);
+    };
+
+    struct Frustum{
+        glm::vec4 Planes[6];
+
+        /// @brief Extract the six normalized clip planes from a view projection matrix.
+        /// @param viewProjection Combined projection and view matrix
+        /// @return Extracted frustum
+        static Frustum FromMatrix(const glm::mat4& viewProjection);
+
+        /// @brief Check if a sphere is at least partially inside the frustum.
+        /// @param center Sphere center
+        /// @param radius Sphere radius
+        /// @return If the sphere intersects the frustum
+        bool IntersectsSphere(glm::vec3 center, float radius) const;
+
+        /// @brief Check if a box is at least partially inside the frustum.
+        /// @param bounds Box to check
+        /// @return If the box intersects the frustum
+        bool IntersectsAABB(const AABB& bounds) const;
+    };
+
     class Math{
         public:
             /// @brief PI to 20 decimal places
@@ -86,6 +168,14 @@ namespace GLEP{
             /// @return Deserialized glm::quat
             static glm::quat QuatFromJson(const json& data);
 
+            /// @brief Calculate a bounding sphere enclosing a transformed bounding box.
+            /// @param boundsMin Minimum corner of the local space bounding box
+            /// @param boundsMax Maximum corner of the local space bounding box
+            /// @param transform Local to world transform
+            /// @param center Resulting sphere center
+            /// @param radius Resulting sphere radius
+            static void BoundsToSphere(glm::vec3 boundsMin, glm::vec3 boundsMax, const glm::mat4& transform, glm::vec3& center, float& radius);
+
             /// @brief Linearly interpolate from one value to another.
             /// @tparam T Target type
             /// @param v0 Start value
@@ -0,0 +1,169 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef WORLD_PARTITION_HPP
+#define WORLD_PARTITION_HPP
+
+#include <GLEP/core/utility/print.hpp>
+#include <GLEP/core/utility/mapped_file.hpp>
+#include <GLEP/core/scene_object.hpp>
+#include <GLEP/core/geometry.hpp>
+#include <GLEP/core/utility/deferred_gl.hpp>
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <filesystem>
+#include <chrono>
+
+#include <nlohmann/json.hpp>
+#include <glm/glm.hpp>
+
+namespace GLEP {
+
+    using json = nlohmann::ordered_json;
+
+    class Scene;
+
+    enum class CellState{
+        UNLOADED,
+        READING,
+        INSTANTIATING,
+        LOADED,
+        EVICTING
+    };
+
+    struct PartitionCell{
+        glm::ivec2 Coord = glm::ivec2(0);
+        std::filesystem::path Path;
+        size_t CpuBytes = 0;
+        size_t GpuBytes = 0;
+
+        CellState State = CellState::UNLOADED;
+        bool Cancelled = false;
+        std::vector<std::shared_ptr<SceneObject>> Objects;
+
+        //Objects are built by the worker, GL work recorded per object runs when it is added to the scene
+        std::vector<DeferredGLTaskList> GlTasks;
+        int NextObject = 0;
+    };
+
+    struct WorldPartitionStats{
+        int LoadedCells = 0;
+        int PendingCells = 0;
+        size_t CpuBytes = 0;
+        size_t GpuBytes = 0;
+        int ObjectsAdded = 0;
+        int ObjectsRemoved = 0;
+    };
+
+    class WorldPartition{
+        private:
+            std::filesystem::path _directory;
+            std::vector<PartitionCell> _cells;
+
+            std::thread _worker;
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            std::deque<int> _requests;
+            std::vector<int> _completed;
+            bool _stopping = false;
+
+            //Per-update scratch, kept between frames so a steady update doesn't allocate
+            std::vector<int> _processing;
+            std::vector<float> _distances;
+            std::vector<int> _resident;
+            std::vector<int> _candidates;
+
+            WorldPartitionStats _stats;
+            std::chrono::steady_clock::time_point _deadline;
+
+            void workerLoop();
+            void readCell(PartitionCell& cell);
+            float cellDistance(const PartitionCell& cell, glm::vec3 position);
+            void request(int index);
+            void evict(int index);
+            bool outOfTime();
+            void instantiate(Scene& scene);
+            void remove(Scene& scene);
+
+        public:
+            float CellSize = 64.0f;
+            float StreamingRadius = 128.0f;
+            float EvictionMargin = 16.0f;
+            size_t CpuBudget = 0;
+            size_t GpuBudget = 0;
+            float FrameBudgetMs = 2.0f;
+
+            WorldPartition();
+            ~WorldPartition();
+
+            WorldPartition(const WorldPartition&) = delete;
+            WorldPartition& operator=(const WorldPartition&) = delete;
+
+
+            /// @brief Get the cells of the partition.
+            /// @return Cells
+            const std::vector<PartitionCell>& GetCells();
+
+            /// @brief Get streaming statistics, object counts are for the last update.
+            /// @return Streaming statistics
+            WorldPartitionStats GetStats();
+
+
+            /// @brief Stream cells around a position. Cells are read and their objects built on a background thread, then added to the scene for up to FrameBudgetMs per update.
+            /// @param scene Scene to add and remove cell objects from
+            /// @param position Streaming origin, usually the target camera's position
+            void Update(Scene& scene, glm::vec3 position);
+
+            /// @brief Remove every streamed object from the scene and cancel pending loads.
+            /// @param scene Scene streamed objects were added to
+            void UnloadAll(Scene& scene);
+
+
+            /// @brief Serialize the partition manifest to JSON format.
+            /// @return Serialized data
+            json ToJson();
+
+            /// @brief Deserialize a partition manifest from JSON format.
+            /// @param data Manifest data in JSON format
+            /// @param directory Directory cell paths are relative to
+            /// @return Deserialized WorldPartition
+            static std::shared_ptr<WorldPartition> FromJson(const json& data, std::filesystem::path directory);
+
+            /// @brief Import a partition manifest from a JSON file, cell paths are relative to its directory.
+            /// @param filePath Manifest file path
+            /// @return Deserialized WorldPartition
+            static std::shared_ptr<WorldPartition> ImportFromFile(std::filesystem::path filePath);
+
+            /// @brief Split the objects of a scene into cell files and write a manifest for them. Lights, probes and the skybox stay in the scene.
+            /// @param scene Scene to split
+            /// @param directory Directory to write the manifest and cells to
+            /// @param cellSize Width and depth of each cell
+            /// @param binary Write cells as binary scene files
+            /// @return If every file was written successfully
+            static bool Export(const std::shared_ptr<Scene>& scene, std::filesystem::path directory, float cellSize, bool binary = true);
+    };
+
+}
+
+#endif //WORLD_PARTITION_HPP
@@ -29,6 +29,8 @@ uniform vec3 viewPos;
 out Vertex v;
 out GLEPInfo i;
 
+invariant gl_Position;
+
 void main(){
     v.position = vec3(model * vec4(aPos, 1.0));
     v.normal = mat3(transpose(inverse(model))) * aNormal;  
@@ -0,0 +1,48 @@
+#version 330 core
+out vec4 FragColor;
+
+struct Vertex {
+    vec3 position;
+    vec3 normal;
+    vec2 uv;
+};
+
+in Vertex v;
+
+struct Framebuffer{
+    sampler2D color;
+    sampler2D depth;
+};
+
+struct Material{
+    vec2 texelSize;
+    float threshold;
+    bool prefilter;
+};
+
+uniform Framebuffer uFramebuffer;
+
+uniform Material uMaterial;
+
+vec3 fetch(vec2 uv){
+    vec3 color = texture(uFramebuffer.color, uv).rgb;
+    if(!uMaterial.prefilter) return color;
+
+    //Only the part of each texel brighter than the threshold contributes to the bloom
+    float brightness = max(color.r, max(color.g, color.b));
+    return color * max(brightness - uMaterial.threshold, 0.0) / max(brightness, 0.0001);
+}
+
+void main()
+{
+    //Dual filter downsample, each corner tap averages a 2x2 block of the source
+    vec2 offset = uMaterial.texelSize;
+
+    vec3 color = fetch(v.uv) * 4.0;
+    color += fetch(v.uv + vec2(-offset.x, -offset.y));
+    color += fetch(v.uv + vec2(offset.x, -offset.y));
+    color += fetch(v.uv + vec2(-offset.x, offset.y));
+    color += fetch(v.uv + vec2(offset.x, offset.y));
+
+    FragColor = vec4(color / 8.0, 1.0);
+}
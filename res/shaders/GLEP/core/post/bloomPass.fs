@@ -0,0 +1,32 @@
+#version 330 core
+out vec4 FragColor;
+
+struct Vertex {
+    vec3 position;
+    vec3 normal;
+    vec2 uv;
+};
+
+in Vertex v;
+
+struct Framebuffer{
+    sampler2D color;
+    sampler2D depth;
+};
+
+struct Material{
+    sampler2D bloom;
+    float intensity;
+};
+
+uniform Framebuffer uFramebuffer;
+
+uniform Material uMaterial;
+
+void main()
+{
+    vec3 color = texture(uFramebuffer.color, v.uv).rgb;
+    vec3 bloom = texture(uMaterial.bloom, v.uv).rgb;
+
+    FragColor = vec4(color + bloom * uMaterial.intensity, 1.0);
+}
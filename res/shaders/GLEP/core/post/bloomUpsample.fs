@@ -0,0 +1,40 @@
+#version 330 core
+out vec4 FragColor;
+
+struct Vertex {
+    vec3 position;
+    vec3 normal;
+    vec2 uv;
+};
+
+in Vertex v;
+
+struct Framebuffer{
+    sampler2D color;
+    sampler2D depth;
+};
+
+struct Material{
+    vec2 texelSize;
+};
+
+uniform Framebuffer uFramebuffer;
+
+uniform Material uMaterial;
+
+void main()
+{
+    //Dual filter upsample of the lower mip, added on top of the current level by blending
+    vec2 offset = uMaterial.texelSize * 0.5;
+
+    vec3 color = texture(uFramebuffer.color, v.uv + vec2(-offset.x * 2.0, 0.0)).rgb;
+    color += texture(uFramebuffer.color, v.uv + vec2(offset.x * 2.0, 0.0)).rgb;
+    color += texture(uFramebuffer.color, v.uv + vec2(0.0, -offset.y * 2.0)).rgb;
+    color += texture(uFramebuffer.color, v.uv + vec2(0.0, offset.y * 2.0)).rgb;
+    color += texture(uFramebuffer.color, v.uv + vec2(-offset.x, -offset.y)).rgb * 2.0;
+    color += texture(uFramebuffer.color, v.uv + vec2(offset.x, -offset.y)).rgb * 2.0;
+    color += texture(uFramebuffer.color, v.uv + vec2(-offset.x, offset.y)).rgb * 2.0;
+    color += texture(uFramebuffer.color, v.uv + vec2(offset.x, offset.y)).rgb * 2.0;
+
+    FragColor = vec4(color / 12.0, 1.0);
+}
@@ -0,0 +1,42 @@
+#version 330 core
+out vec4 FragColor;
+
+struct Vertex {
+    vec3 position;
+    vec3 normal;
+    vec2 uv;
+};
+
+in Vertex v;
+
+struct Framebuffer{
+    sampler2D color;
+    sampler2D depth;
+};
+
+#define MAX_TAPS 32
+
+struct Material{
+    vec2 direction;
+    int taps;
+    float weights[MAX_TAPS];
+    float offsets[MAX_TAPS];
+};
+
+uniform Framebuffer uFramebuffer;
+
+uniform Material uMaterial;
+
+void main()
+{
+    vec3 color = texture(uFramebuffer.color, v.uv).rgb * uMaterial.weights[0];
+
+    //Taps past the center sit between two texels, so the bilinear filter weights both in a single fetch
+    for(int i = 1; i < uMaterial.taps; i++){
+        vec2 offset = uMaterial.direction * uMaterial.offsets[i];
+        color += texture(uFramebuffer.color, v.uv + offset).rgb * uMaterial.weights[i];
+        color += texture(uFramebuffer.color, v.uv - offset).rgb * uMaterial.weights[i];
+    }
+
+    FragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,44 @@
+#version 330 core
+out vec4 FragColor;
+
+struct Vertex {
+    vec3 position;
+    vec3 normal;
+    vec2 uv;
+};
+
+in Vertex v;
+
+struct Framebuffer{
+    sampler2D color;
+    sampler2D depth;
+};
+
+struct Material{
+    vec2 texelSize;
+    float sharpness;
+};
+
+uniform Framebuffer uFramebuffer;
+
+uniform Material uMaterial;
+
+void main()
+{
+    //Bilinear sample of the lower resolution source
+    vec3 center = texture(uFramebuffer.color, v.uv).rgb;
+
+    vec3 north = texture(uFramebuffer.color, v.uv + vec2(0.0, uMaterial.texelSize.y)).rgb;
+    vec3 south = texture(uFramebuffer.color, v.uv - vec2(0.0, uMaterial.texelSize.y)).rgb;
+    vec3 east = texture(uFramebuffer.color, v.uv + vec2(uMaterial.texelSize.x, 0.0)).rgb;
+    vec3 west = texture(uFramebuffer.color, v.uv - vec2(uMaterial.texelSize.x, 0.0)).rgb;
+
+    vec3 minColor = min(center, min(min(north, south), min(east, west)));
+    vec3 maxColor = max(center, max(max(north, south), max(east, west)));
+
+    //Sharpen less across strong edges, and never beyond the local range to avoid ringing
+    vec3 amount = uMaterial.sharpness * (1.0 - clamp(maxColor - minColor, 0.0, 1.0));
+    vec3 color = center + (4.0 * center - north - south - east - west) * 0.25 * amount;
+
+    FragColor = vec4(clamp(color, minColor, maxColor), 1.0);
+}
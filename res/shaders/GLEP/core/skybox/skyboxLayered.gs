@@ -0,0 +1,32 @@
+#version 330 core
+
+layout (triangles) in;
+layout (triangle_strip, max_vertices = 18) out;
+
+struct Vertex {
+    vec3 position;
+    vec3 normal;
+    vec3 uv;
+};
+
+uniform mat4 uCubeViewProjection[6];
+uniform int uCubeFaceMask;
+
+in Vertex vertexData[];
+
+out Vertex v;
+
+void main(){
+    for(int face = 0; face < 6; face++){
+        if((uCubeFaceMask & (1 << face)) == 0) continue;
+
+        for(int n = 0; n < 3; n++){
+            v = vertexData[n];
+            gl_Layer = face;
+            vec4 pos = uCubeViewProjection[face] * vec4(vertexData[n].position, 1.0);
+            gl_Position = pos.xyww;
+            EmitVertex();
+        }
+        EndPrimitive();
+    }
+}
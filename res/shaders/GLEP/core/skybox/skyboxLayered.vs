@@ -0,0 +1,22 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+
+struct Vertex {
+    vec3 position;
+    vec3 normal;
+    vec3 uv;
+};
+
+out Vertex vertexData;
+
+void main(){
+    vertexData.position = aPos;
+    vertexData.normal = aNormal;  
+    vertexData.uv = aPos;
+
+    //Projected per cube face in skyboxLayered.gs
+    gl_Position = vec4(aPos, 1.0);
+}
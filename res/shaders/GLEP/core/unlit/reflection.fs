@@ -15,6 +15,8 @@ struct GLEPInfo {
 
 struct Material {
     samplerCube cubeMap;
+    samplerCube blendCubeMap;
+    float blend;
     vec4 tint;
 };
 
@@ -29,7 +31,7 @@ void main()
     vec3 I = normalize(v.position - i.viewPos);
     vec3 R = reflect(I, normalize(v.normal));
 
-    vec3 finalColor = texture(uMaterial.cubeMap, R).rgb;
+    vec3 finalColor = mix(texture(uMaterial.cubeMap, R).rgb, texture(uMaterial.blendCubeMap, R).rgb, uMaterial.blend);
     finalColor *= uMaterial.tint.rgb;
 
     FragColor = vec4(finalColor, 1.0);
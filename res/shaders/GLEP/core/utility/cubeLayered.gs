@@ -0,0 +1,42 @@
+#version 330 core
+
+layout (triangles) in;
+layout (triangle_strip, max_vertices = 18) out;
+
+struct Vertex {
+    vec3 position;
+    vec4 lightSpacePosition;
+    vec3 normal;
+    vec2 uv;
+};
+
+struct GLEPInfo {
+    float time;
+    float deltaTime;
+    vec3 viewPos;
+};
+
+uniform mat4 uCubeViewProjection[6];
+uniform int uCubeFaceMask;
+
+in Vertex vertexData[];
+in GLEPInfo infoData[];
+
+out Vertex v;
+out GLEPInfo i;
+
+void main(){
+    for(int face = 0; face < 6; face++){
+        //Faces culled on the CPU are skipped entirely
+        if((uCubeFaceMask & (1 << face)) == 0) continue;
+
+        for(int n = 0; n < 3; n++){
+            v = vertexData[n];
+            i = infoData[n];
+            gl_Layer = face;
+            gl_Position = uCubeViewProjection[face] * vec4(vertexData[n].position, 1.0);
+            EmitVertex();
+        }
+        EndPrimitive();
+    }
+}
@@ -0,0 +1,42 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+
+struct Vertex {
+    vec3 position;
+    vec4 lightSpacePosition;
+    vec3 normal;
+    vec2 uv;
+};
+
+struct GLEPInfo {
+    float time;
+    float deltaTime;
+    vec3 viewPos;
+};
+
+uniform mat4 model;
+uniform mat4 lightSpaceMatrix;
+
+uniform float time;
+uniform float deltaTime;
+uniform vec3 viewPos;
+
+out Vertex vertexData;
+out GLEPInfo infoData;
+
+void main(){
+    vertexData.position = vec3(model * vec4(aPos, 1.0));
+    vertexData.normal = mat3(transpose(inverse(model))) * aNormal;  
+    vertexData.uv = aTexCoords;
+    vertexData.lightSpacePosition = lightSpaceMatrix * vec4(vertexData.position, 1.0);
+
+    infoData.time = time;
+    infoData.deltaTime = deltaTime;
+    infoData.viewPos = viewPos;
+
+    //Projected per cube face in cubeLayered.gs
+    gl_Position = vec4(vertexData.position, 1.0);
+}
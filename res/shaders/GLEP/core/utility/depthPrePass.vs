@@ -0,0 +1,24 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec2 aTexCoords;
+
+struct Vertex {
+    vec2 uv;
+};
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+out Vertex v;
+
+//Must match default.vs exactly so the shading pass can depth test with GL_EQUAL
+invariant gl_Position;
+
+void main(){
+    vec3 position = vec3(model * vec4(aPos, 1.0));
+    v.uv = aTexCoords;
+
+    gl_Position = projection * view * vec4(position, 1.0);
+}
@@ -0,0 +1,19 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec2 aTexCoords;
+
+struct Vertex {
+    vec2 uv;
+};
+
+uniform mat4 model;
+uniform mat4 lightSpaceMatrix;
+
+out Vertex v;
+
+void main(){
+    v.uv = aTexCoords;
+
+    gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+}
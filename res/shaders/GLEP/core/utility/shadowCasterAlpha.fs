@@ -0,0 +1,13 @@
+#version 330 core
+
+struct Vertex {
+    vec2 uv;
+};
+
+in Vertex v;
+
+uniform sampler2D uAlphaTex;
+
+void main(){
+    if(texture(uAlphaTex, v.uv).a < 0.1f) discard;
+}
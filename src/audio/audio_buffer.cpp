@@ -17,25 +17,195 @@
 
 #include <GLEP/audio/audio_buffer.hpp>
 
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+
 namespace GLEP::Audio{
+
+    static const char PCM_CACHE_MAGIC[8] = {'G', 'L', 'E', 'P', 'P', 'C', 'M', '1'};
+
+    //Samples start on a 64 byte boundary so the mapping can be handed to OpenAL as is
+    struct PcmCacheHeader{
+        char Magic[8];
+        uint64_t SourceHash;
+        uint32_t Channels;
+        uint32_t SampleRate;
+        uint64_t Frames;
+        uint8_t Padding[32];
+    };
+
+    static_assert(sizeof(PcmCacheHeader) == 64, "PCM cache header must be 64 bytes");
+
+    std::filesystem::path AudioBuffer::CacheDirectory;
+    AudioCacheStats AudioBuffer::_cacheStats;
+
+    //FNV-1a over 8 byte words, only used to key the cache
+    static bool hashFile(std::filesystem::path filePath, uint64_t& hash){
+        MappedFile file;
+        if(!file.Open(filePath)) return false;
+
+        const unsigned char* data = file.GetData();
+        size_t size = file.GetSize();
+
+        hash = 14695981039346656037ull ^ size;
+        size_t i = 0;
+        for(; i + 8 <= size; i += 8){
+            uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            hash = (hash ^ word) * 1099511628211ull;
+        }
+        for(; i < size; i++){
+            hash = (hash ^ data[i]) * 1099511628211ull;
+        }
+
+        return true;
+    }
+
+    static PFNALBUFFERDATASTATICPROC getBufferDataStatic(){
+        static PFNALBUFFERDATASTATICPROC bufferDataStatic = alIsExtensionPresent("AL_EXT_STATIC_BUFFER") ? (PFNALBUFFERDATASTATICPROC)alGetProcAddress("alBufferDataStatic") : nullptr;
+        return bufferDataStatic;
+    }
+
+    static float elapsedMs(std::chrono::steady_clock::time_point start){
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
     AudioBuffer::AudioBuffer(uint32_t bufferID){
         _ID = bufferID;
     }
 
     AudioBuffer::AudioBuffer(std::filesystem::path filePath){
         _filePath = filePath;
-        _ID = LoadSoundFile(_filePath);
+        _ID = loadSoundFile(_filePath, &_pcm);
     }
 
     AudioBuffer::~AudioBuffer(){
         alDeleteBuffers(1, &_ID);
+        if(_pcm) _cacheStats.MappedBytes -= _pcm->GetSize();
     }
 
     std::filesystem::path AudioBuffer::GetFilePath(){ return _filePath; }
     uint32_t AudioBuffer::GetID(){ return _ID; }
+    bool AudioBuffer::GetIsStatic(){ return _pcm != nullptr; }
+
+    float AudioBuffer::GetDuration(){
+        ALint size = 0, channels = 1, bits = 16, frequency = 0;
+        alGetBufferi(_ID, AL_SIZE, &size);
+        alGetBufferi(_ID, AL_CHANNELS, &channels);
+        alGetBufferi(_ID, AL_BITS, &bits);
+        alGetBufferi(_ID, AL_FREQUENCY, &frequency);
+
+        if(frequency <= 0 || channels <= 0 || bits <= 0) return 0.0f;
+        return (float)size / (channels * (bits / 8)) / frequency;
+    }
+
+    int AudioBuffer::GetChannels(){
+        ALint channels = 1;
+        alGetBufferi(_ID, AL_CHANNELS, &channels);
+        return channels;
+    }
+
+    AudioCacheStats AudioBuffer::GetCacheStats(){ return _cacheStats; }
 
-    //Heavily inspired by OpenAL Soft example alplay.c and Code, Tech, and Tutorials - OpenAL Tutorial pt.1 | Init and Play Sound Effects
     uint32_t AudioBuffer::LoadSoundFile(std::filesystem::path filePath){
+        return loadSoundFile(filePath, nullptr);
+    }
+
+    uint32_t AudioBuffer::loadCached(std::filesystem::path cachePath, uint64_t sourceHash, std::unique_ptr<MappedFile>* pcm){
+        std::unique_ptr<MappedFile> file = std::make_unique<MappedFile>();
+        if(!file->Open(cachePath) || file->GetSize() < sizeof(PcmCacheHeader)) return 0;
+
+        PcmCacheHeader header;
+        std::memcpy(&header, file->GetData(), sizeof(header));
+
+        size_t bytes = (size_t)header.Frames * header.Channels * sizeof(short);
+        if(std::memcmp(header.Magic, PCM_CACHE_MAGIC, sizeof(PCM_CACHE_MAGIC)) != 0 || header.SourceHash != sourceHash
+            || (header.Channels != 1 && header.Channels != 2) || file->GetSize() != sizeof(header) + bytes){
+            return 0;
+        }
+
+        ALenum format = header.Channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+        ALvoid* samples = (ALvoid*)(file->GetData() + sizeof(header));
+
+        //Clear errors left by earlier calls so they aren't taken for a failed cache load
+        alGetError();
+        uint32_t buffer = 0;
+        alGenBuffers(1, &buffer);
+
+        //With static buffers OpenAL reads the mapped pages directly, otherwise it copies once straight from the mapping
+        PFNALBUFFERDATASTATICPROC bufferDataStatic = pcm ? getBufferDataStatic() : nullptr;
+        if(bufferDataStatic){
+            bufferDataStatic(buffer, format, samples, (ALsizei)bytes, (ALsizei)header.SampleRate);
+        } else {
+            alBufferData(buffer, format, samples, (ALsizei)bytes, (ALsizei)header.SampleRate);
+        }
+
+        if(alGetError() != AL_NO_ERROR){
+            Print(PrintCode::ERROR, "AUDIO_BUFFER", "Error loading alBuffer from cache: " + cachePath.string());
+            if(buffer && alIsBuffer(buffer)) alDeleteBuffers(1, &buffer);
+            return 0;
+        }
+
+        if(bufferDataStatic){
+            _cacheStats.StaticBuffers++;
+            _cacheStats.MappedBytes += file->GetSize();
+            *pcm = std::move(file);
+        }
+
+        return buffer;
+    }
+
+    void AudioBuffer::writeCache(std::filesystem::path cachePath, uint64_t sourceHash, const short* samples, int64_t frames, int channels, int sampleRate){
+        PcmCacheHeader header = {};
+        std::memcpy(header.Magic, PCM_CACHE_MAGIC, sizeof(PCM_CACHE_MAGIC));
+        header.SourceHash = sourceHash;
+        header.Channels = (uint32_t)channels;
+        header.SampleRate = (uint32_t)sampleRate;
+        header.Frames = (uint64_t)frames;
+
+        std::error_code error;
+        std::filesystem::create_directories(CacheDirectory, error);
+
+        //Written beside the cache and renamed, so a concurrent or interrupted load never maps a partial file
+        std::filesystem::path tempPath = cachePath;
+        tempPath += ".tmp";
+
+        std::ofstream f(tempPath, std::ios::binary);
+        f.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        f.write(reinterpret_cast<const char*>(samples), (std::streamsize)(frames * channels * sizeof(short)));
+        f.close();
+
+        if(!f){
+            Print(PrintCode::ERROR, "AUDIO_BUFFER", "Failed to write decode cache: " + cachePath.string());
+            std::filesystem::remove(tempPath, error);
+            return;
+        }
+
+        std::filesystem::rename(tempPath, cachePath, error);
+        if(error) std::filesystem::remove(tempPath, error);
+    }
+
+    //Heavily inspired by OpenAL Soft example alplay.c and Code, Tech, and Tutorials - OpenAL Tutorial pt.1 | Init and Play Sound Effects
+    uint32_t AudioBuffer::loadSoundFile(std::filesystem::path filePath, std::unique_ptr<MappedFile>* pcm){
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        uint64_t sourceHash = 0;
+        std::filesystem::path cachePath;
+        if(!CacheDirectory.empty() && hashFile(filePath, sourceHash)){
+            char name[32];
+            std::snprintf(name, sizeof(name), "%016llx.s16.pcm", (unsigned long long)sourceHash);
+            cachePath = CacheDirectory / name;
+
+            uint32_t cached = loadCached(cachePath, sourceHash, pcm);
+            if(cached){
+                _cacheStats.Hits++;
+                _cacheStats.CacheTimeMs += elapsedMs(start);
+                return cached;
+            }
+        }
+
         ALenum err, format;
         uint32_t buffer;
         SNDFILE* sndfile;
@@ -83,6 +253,12 @@ namespace GLEP::Audio{
         alGenBuffers(1, &buffer);
         alBufferData(buffer, format, membuf, num_bytes, sfinfo.samplerate);
 
+        if(!cachePath.empty()){
+            writeCache(cachePath, sourceHash, membuf, num_frames, sfinfo.channels, sfinfo.samplerate);
+            _cacheStats.Misses++;
+        }
+        _cacheStats.DecodeTimeMs += elapsedMs(start);
+
         free(membuf);
         sf_close(sndfile);
 
@@ -16,6 +16,7 @@
  */
 
 #include <GLEP/audio/audio_engine.hpp>
+#include <GLEP/audio/voice_manager.hpp>
 
 namespace GLEP::Audio{
 
@@ -26,6 +27,8 @@ namespace GLEP::Audio{
     }
 
     AudioEngine::~AudioEngine(){        
+        VoiceManager::Shutdown();
+
         alcMakeContextCurrent(nullptr);
         alcDestroyContext(_alContext);
         alcCloseDevice(_alDevice); 
@@ -65,10 +68,16 @@ namespace GLEP::Audio{
         Print(PrintCode::INFO, "AUDIO_ENGINE", "Opened " + std::string(name));
 
         AudioEffect::Initialize(_alDevice);
+        VoiceManager::Initialize(_alDevice);
     }
 
     float AudioEngine::GetSampleRate(){ return _sampleRate; }
 
+    void AudioEngine::Update(glm::vec3 listenerPosition){
+        alListener3f(AL_POSITION, listenerPosition.x, listenerPosition.y, listenerPosition.z);
+        VoiceManager::Update(listenerPosition);
+    }
+
     uint32_t AudioEngine::GenerateWave(float sampleRate, WaveType type, float frequency, float amplitude) {
         std::vector<short> membuf;
 
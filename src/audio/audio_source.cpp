@@ -16,6 +16,9 @@
  */
 
 #include <GLEP/audio/audio_source.hpp>
+#include <GLEP/audio/voice_manager.hpp>
+
+#include <cmath>
 
 namespace GLEP::Audio{
     AudioSource::AudioSource(){
@@ -27,21 +30,75 @@ namespace GLEP::Audio{
         initialize();
     }
 
+    AudioSource::AudioSource(std::shared_ptr<AudioStream> stream){
+        initialize();
+        SetStream(stream);
+    }
+
     void AudioSource::initialize(){
-        alGenSources(1, &_alSource);
+        if(_buffer){
+            _duration = _buffer->GetDuration();
+            _channels = _buffer->GetChannels();
+        }
+        VoiceManager::Register(this);
+    }
+
+    void AudioSource::realize(ALuint alSource){
+        _alSource = alSource;
+
         alSourcef(_alSource, AL_PITCH, _pitch);
         alSourcef(_alSource, AL_GAIN, _gain);
         alSource3f(_alSource, AL_POSITION, _position.x, _position.y, _position.z);
         alSource3f(_alSource, AL_VELOCITY, _velocity.x, _velocity.y, _velocity.z);
-        alSourcei(_alSource, AL_LOOPING, _loop);
+        alSourcei(_alSource, AL_SOURCE_RELATIVE, _relative);
+
+        for(EffectSlot slot : _effects){
+            alSource3i(_alSource, AL_AUXILIARY_SEND_FILTER, slot.AlSlot, 0, AL_FILTER_NULL);
+        }
+
+        //Pick up where the virtual playback is, so the voice is heard from the right point
+        float time = virtualTime();
+        if(_stream){
+            _stream->Attach(_alSource);
+            if(time > 0.0f) _stream->Seek(time);
+            if(_state == AudioSourceState::PLAYING) _stream->Play();
+        } else {
+            alSourcei(_alSource, AL_LOOPING, _loop);
+            alSourcei(_alSource, AL_BUFFER, _buffer ? _buffer->GetID() : 0);
+            alSourcef(_alSource, AL_SEC_OFFSET, time);
+            if(_state == AudioSourceState::PLAYING) alSourcePlay(_alSource);
+        }
+    }
+
+    ALuint AudioSource::virtualize(){
+        //Re-reads the state, so a voice that just finished is stopped rather than resumed later
+        GetState();
+        _offset = _state == AudioSourceState::STOPPED ? 0.0f : GetTime();
+        _offsetTime = std::chrono::steady_clock::now();
+
+        if(_stream) _stream->Detach();
+        alSourceStop(_alSource);
+        alSourcei(_alSource, AL_BUFFER, 0);
+        alSource3i(_alSource, AL_AUXILIARY_SEND_FILTER, AL_EFFECTSLOT_NULL, 0, AL_FILTER_NULL);
+
+        ALuint alSource = _alSource;
+        _alSource = 0;
+        return alSource;
+    }
+
+    float AudioSource::virtualTime(){
+        if(_state != AudioSourceState::PLAYING) return _offset;
 
-        uint32_t bufferData = 0;
-        if(_buffer) bufferData = _buffer->GetID();
-        alSourcei(_alSource, AL_BUFFER, bufferData);
+        float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - _offsetTime).count();
+        float time = _offset + elapsed * _pitch;
+
+        if(_duration <= 0.0f) return 0.0f;
+        if(_loop) return std::fmod(time, _duration);
+        return std::fmin(time, _duration);
     }
 
     AudioSource::~AudioSource(){
-        alDeleteSources(1, &_alSource);
+        VoiceManager::Unregister(this);
         for(EffectSlot slot : _effects){
             AudioEffect::alDeleteAuxiliaryEffectSlots(1, &slot.AlSlot);
         }
@@ -52,39 +109,96 @@ namespace GLEP::Audio{
     glm::vec3 AudioSource::GetPosition(){ return _position; }
     glm::vec3 AudioSource::GetVelocity(){ return _velocity; }
     bool AudioSource::GetLoop(){ return _loop; }
+    bool AudioSource::GetRelative(){ return _relative; }
     std::shared_ptr<AudioBuffer> AudioSource::GetBuffer(){ return _buffer; }
+    std::shared_ptr<AudioStream> AudioSource::GetStream(){ return _stream; }
+    int AudioSource::GetPriority(){ return _priority; }
+    bool AudioSource::GetIsVirtual(){ return _alSource == 0; }
+
+    float AudioSource::GetTime(){
+        if(!_alSource) return virtualTime();
+        if(_stream) return _stream->GetTime();
+
+        float seconds = 0.0f;
+        alGetSourcef(_alSource, AL_SEC_OFFSET, &seconds);
+        return seconds;
+    }
 
     void AudioSource::SetPitch(float pitch){
+        //Keep virtual time continuous across the change
+        _offset = virtualTime();
+        _offsetTime = std::chrono::steady_clock::now();
+
         _pitch = pitch;
-        alSourcef(_alSource, AL_PITCH, _pitch);
+        if(_alSource) alSourcef(_alSource, AL_PITCH, _pitch);
     }
 
     void AudioSource::SetGain(float gain){
         _gain = gain;
-        alSourcef(_alSource, AL_GAIN, _gain);
+        if(_alSource) alSourcef(_alSource, AL_GAIN, _gain);
     }
 
     void AudioSource::SetPosition(glm::vec3 position){
         _position = position;
-        alSource3f(_alSource, AL_POSITION, _position.x, _position.y, _position.z);
+        if(_alSource) alSource3f(_alSource, AL_POSITION, _position.x, _position.y, _position.z);
     }
 
     void AudioSource::SetVelocity(glm::vec3 velocity){
         _velocity = velocity;
-        alSource3f(_alSource, AL_VELOCITY, _velocity.x, _velocity.y, _velocity.z);
+        if(_alSource) alSource3f(_alSource, AL_VELOCITY, _velocity.x, _velocity.y, _velocity.z);
     }
 
     void AudioSource::SetLoop(bool loop){
         _loop = loop;
-        alSourcei(_alSource, AL_LOOPING, _loop);
+        if(_stream) _stream->SetLoop(_loop);
+        else if(_alSource) alSourcei(_alSource, AL_LOOPING, _loop);
+    }
+
+    void AudioSource::SetRelative(bool relative){
+        _relative = relative;
+        if(_alSource) alSourcei(_alSource, AL_SOURCE_RELATIVE, _relative);
+    }
+
+    void AudioSource::SetPriority(int priority){
+        _priority = priority;
     }
 
     void AudioSource::SetBuffer(const std::shared_ptr<AudioBuffer>& buffer){
         if(GetState() != AudioSourceState::STOPPED) 
             Stop();
 
+        if(_stream){
+            if(_alSource) _stream->Detach();
+            _stream = nullptr;
+            if(_alSource) alSourcei(_alSource, AL_LOOPING, _loop);
+        }
+
         _buffer = buffer;
-        alSourcei(_alSource, AL_BUFFER, _buffer->GetID());
+        _duration = _buffer->GetDuration();
+        _channels = _buffer->GetChannels();
+        if(_alSource) alSourcei(_alSource, AL_BUFFER, _buffer->GetID());
+    }
+
+    void AudioSource::SetStream(const std::shared_ptr<AudioStream>& stream){
+        if(_alSource){
+            if(_stream) _stream->Detach();
+            else alSourceStop(_alSource);
+        }
+
+        _buffer = nullptr;
+        _stream = stream;
+        _state = AudioSourceState::INITIAL;
+        _offset = 0.0f;
+        _duration = _stream ? _stream->GetDuration() : 0.0f;
+        _channels = _stream ? _stream->GetChannels() : 1;
+
+        if(!_stream){
+            if(_alSource) alSourcei(_alSource, AL_BUFFER, 0);
+            return;
+        }
+
+        _stream->SetLoop(_loop);
+        if(_alSource) _stream->Attach(_alSource);
     }
 
     void AudioSource::AddEffect(const std::shared_ptr<AudioEffect>& effect){
@@ -106,43 +220,93 @@ namespace GLEP::Audio{
             return;
         }
 
-        alSource3i(_alSource, AL_AUXILIARY_SEND_FILTER, slot.AlSlot, 0, AL_FILTER_NULL);
+        if(_alSource) alSource3i(_alSource, AL_AUXILIARY_SEND_FILTER, slot.AlSlot, 0, AL_FILTER_NULL);
         _effects.push_back(slot);
     }
 
     void AudioSource::Play(){
-        if(!_buffer) 
+        if(!_buffer && !_stream) 
             return;
-        
-        alSourcePlay(_alSource);
+
+        //Like an AL source, a paused source resumes and anything else restarts
+        if(_state != AudioSourceState::PAUSED) _offset = 0.0f;
+        _offsetTime = std::chrono::steady_clock::now();
+        _state = AudioSourceState::PLAYING;
+        _playOrder = VoiceManager::NextPlayOrder();
+
+        if(!_alSource){
+            VoiceManager::Request(this);
+            return;
+        }
+
+        if(_stream) _stream->Play();
+        else alSourcePlay(_alSource);
     }
 
     void AudioSource::Play(const std::shared_ptr<AudioBuffer>& buffer){
         SetBuffer(buffer);
-        alSourcePlay(_alSource);
+        Play();
     }
 
     AudioSourceState AudioSource::GetState(){
-        ALint state;
-        alGetSourcei(_alSource, AL_SOURCE_STATE, &state); 
-        if (alGetError() != AL_NO_ERROR) {
-            Print(PrintCode::ERROR, "AUDIO_SOURCE", "Failed to query source state.");
-            return AudioSourceState::INITIAL;
+        if(_state != AudioSourceState::PLAYING) return _state;
+
+        bool playing;
+        if(!_alSource){
+            playing = _loop || virtualTime() < _duration;
+        } else if(_stream){
+            playing = _stream->GetIsPlaying();
+        } else {
+            ALint state;
+            alGetSourcei(_alSource, AL_SOURCE_STATE, &state); 
+            if (alGetError() != AL_NO_ERROR) {
+                Print(PrintCode::ERROR, "AUDIO_SOURCE", "Failed to query source state.");
+                return AudioSourceState::INITIAL;
+            }
+            playing = state == AL_PLAYING;
+        }
+
+        if(!playing){
+            _state = AudioSourceState::STOPPED;
+            _offset = 0.0f;
         }
-        return (AudioSourceState)state;
+
+        return _state;
     }
 
     void AudioSource::Pause(){
-        if(!_buffer) 
+        if(_state != AudioSourceState::PLAYING) 
             return;
 
-        alSourcePause(_alSource);
+        _offset = GetTime();
+        _state = AudioSourceState::PAUSED;
+
+        if(!_alSource) return;
+        if(_stream) _stream->Pause();
+        else alSourcePause(_alSource);
     }
 
     void AudioSource::Stop(){
-        if(!_buffer) 
+        if(!_buffer && !_stream) 
             return;
-        
-        alSourceStop(_alSource);
+
+        _state = AudioSourceState::STOPPED;
+        _offset = 0.0f;
+
+        if(!_alSource) return;
+        if(_stream) _stream->Stop();
+        else alSourceStop(_alSource);
+    }
+
+    void AudioSource::Seek(float seconds){
+        if(!_buffer && !_stream)
+            return;
+
+        _offset = seconds;
+        _offsetTime = std::chrono::steady_clock::now();
+
+        if(!_alSource) return;
+        if(_stream) _stream->Seek(seconds);
+        else alSourcef(_alSource, AL_SEC_OFFSET, seconds);
     }
-}
\ No newline at end of file
+}
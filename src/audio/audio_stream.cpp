@@ -0,0 +1,298 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <GLEP/audio/audio_stream.hpp>
+
+#include <algorithm>
+
+namespace GLEP::Audio{
+
+    AudioStream::AudioStream(std::filesystem::path filePath, int chunkFrames, int bufferCount){
+        _filePath = filePath;
+
+        _file = sf_open(_filePath.string().c_str(), SFM_READ, &_info);
+        if(!_file){
+            Print(PrintCode::ERROR, "AUDIO_STREAM", "Failed to open file: " + _filePath.string());
+            return;
+        }
+
+        if(_info.frames < 1){
+            Print(PrintCode::ERROR, "AUDIO_STREAM", "Bad sample count in file: " + _filePath.string());
+            sf_close(_file);
+            _file = nullptr;
+            return;
+        }
+
+        if(_info.channels == 1){
+            _format = AL_FORMAT_MONO16;
+        } else if(_info.channels == 2){
+            _format = AL_FORMAT_STEREO16;
+        } else {
+            Print(PrintCode::ERROR, "AUDIO_STREAM", "Unsupported channel count of " + std::to_string(_info.channels) + " in file: " + _filePath.string());
+            sf_close(_file);
+            _file = nullptr;
+            return;
+        }
+
+        chunkFrames = std::max(chunkFrames, 256);
+        bufferCount = std::max(bufferCount, 2);
+
+        _chunk.resize((size_t)chunkFrames * _info.channels);
+        _buffers.resize(bufferCount);
+        alGenBuffers(bufferCount, _buffers.data());
+        _free.reserve(bufferCount);
+        _free.assign(_buffers.begin(), _buffers.end());
+        _queuedStarts.resize(bufferCount);
+
+        //Wake a few times per buffer so a late wake still leaves audio queued
+        _period = std::chrono::milliseconds(std::max(1, (int)((sf_count_t)chunkFrames * 1000 / _info.samplerate / 4)));
+    }
+
+    AudioStream::~AudioStream(){
+        Detach();
+
+        if(!_buffers.empty()) alDeleteBuffers((ALsizei)_buffers.size(), _buffers.data());
+        if(_file) sf_close(_file);
+    }
+
+    std::filesystem::path AudioStream::GetFilePath(){ return _filePath; }
+    bool AudioStream::GetIsValid(){ return _file != nullptr; }
+    int AudioStream::GetSampleRate(){ return _info.samplerate; }
+    float AudioStream::GetDuration(){ return _file ? (float)_info.frames / _info.samplerate : 0.0f; }
+    int AudioStream::GetChannels(){ return _info.channels; }
+
+    float AudioStream::GetTime(){
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(!_file) return 0.0f;
+
+        sf_count_t frame = _cursor;
+        if(_source && _queued > 0){
+            ALint offset = 0;
+            alGetSourcei(_source, AL_SAMPLE_OFFSET, &offset);
+            frame = _queuedStarts[_queueHead] + offset;
+        }
+
+        return (float)(frame % _info.frames) / _info.samplerate;
+    }
+
+    bool AudioStream::GetLoop(){ return _loop; }
+
+    bool AudioStream::GetIsPlaying(){
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _playing;
+    }
+
+    AudioStreamStats AudioStream::GetStats(){
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        AudioStreamStats stats = _stats;
+        stats.QueuedBuffers = _queued;
+        return stats;
+    }
+
+    void AudioStream::SetLoop(bool loop){
+        std::lock_guard<std::mutex> lock(_mutex);
+        _loop = loop;
+        if(_loop) _ended = false;
+    }
+
+    void AudioStream::workerLoop(){
+        std::unique_lock<std::mutex> lock(_mutex);
+        while(!_stopping){
+            service();
+            _condition.wait_for(lock, _period);
+        }
+    }
+
+    void AudioStream::service(){
+        //A stopped source reports its whole queue as processed, only a running stream consumes buffers
+        if(!_source || !_playing) return;
+
+        ALint processed = 0;
+        alGetSourcei(_source, AL_BUFFERS_PROCESSED, &processed);
+        while(processed-- > 0){
+            ALuint buffer;
+            alSourceUnqueueBuffers(_source, 1, &buffer);
+            _free.push_back(buffer);
+            _queueHead = (_queueHead + 1) % (int)_buffers.size();
+            _queued--;
+        }
+
+        while(fill());
+
+        ALint state;
+        alGetSourcei(_source, AL_SOURCE_STATE, &state);
+        if(state == AL_PLAYING) return;
+
+        //A source that runs dry stops, restart it once there is audio again
+        if(_queued > 0){
+            alSourcePlay(_source);
+            _stats.Underruns++;
+        } else {
+            _playing = false;
+            _finished = true;
+        }
+    }
+
+    bool AudioStream::fill(){
+        if(_free.empty() || _ended) return false;
+
+        sf_count_t chunkFrames = (sf_count_t)_chunk.size() / _info.channels;
+        sf_count_t start = _cursor;
+        sf_count_t frames = 0;
+
+        while(frames < chunkFrames){
+            sf_count_t read = sf_readf_short(_file, _chunk.data() + frames * _info.channels, chunkFrames - frames);
+            frames += read;
+            _cursor += read;
+
+            if(frames == chunkFrames) break;
+
+            //End of file, wrap within the same buffer so the loop point is seamless
+            if(!_loop || (read == 0 && _cursor == 0)){
+                _ended = true;
+                break;
+            }
+
+            sf_seek(_file, 0, SEEK_SET);
+            _cursor = 0;
+        }
+
+        if(frames == 0) return false;
+
+        ALuint buffer = _free.back();
+        _free.pop_back();
+
+        alBufferData(buffer, _format, _chunk.data(), (ALsizei)(frames * _info.channels * sizeof(short)), _info.samplerate);
+        alSourceQueueBuffers(_source, 1, &buffer);
+
+        _queuedStarts[(_queueHead + _queued) % (int)_buffers.size()] = start;
+        _queued++;
+        _stats.DecodedFrames += (size_t)frames;
+
+        return true;
+    }
+
+    void AudioStream::prefill(){
+        while(fill());
+    }
+
+    void AudioStream::rewind(sf_count_t frame){
+        alSourceStop(_source);
+        alSourcei(_source, AL_BUFFER, 0);
+
+        _free.assign(_buffers.begin(), _buffers.end());
+        _queueHead = 0;
+        _queued = 0;
+
+        sf_seek(_file, frame, SEEK_SET);
+        _cursor = frame;
+        _ended = false;
+        _finished = false;
+
+        prefill();
+    }
+
+    void AudioStream::Attach(ALuint source){
+        if(!_file) return;
+
+        Detach();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _source = source;
+        _stopping = false;
+        _playing = false;
+
+        //Looping is handled while decoding, the source itself must run off the end of its queue
+        alSourcei(_source, AL_LOOPING, AL_FALSE);
+        rewind(0);
+
+        _worker = std::thread(&AudioStream::workerLoop, this);
+    }
+
+    void AudioStream::Detach(){
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if(!_source) return;
+            _stopping = true;
+        }
+        _condition.notify_all();
+
+        if(_worker.joinable()) _worker.join();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        alSourceStop(_source);
+        alSourcei(_source, AL_BUFFER, 0);
+
+        _free.assign(_buffers.begin(), _buffers.end());
+        _queueHead = 0;
+        _queued = 0;
+        _source = 0;
+        _playing = false;
+    }
+
+    void AudioStream::Play(){
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(!_source) return;
+
+        //Catch an end of stream the thread hasn't seen yet
+        service();
+
+        ALint state;
+        alGetSourcei(_source, AL_SOURCE_STATE, &state);
+
+        //Match a static buffer, playing again restarts and a finished stream starts over
+        if(state == AL_PLAYING || _finished){
+            rewind(0);
+        } else if(_queued == 0){
+            prefill();
+        }
+
+        alSourcePlay(_source);
+        _playing = true;
+    }
+
+    void AudioStream::Pause(){
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(!_source) return;
+
+        alSourcePause(_source);
+        _playing = false;
+    }
+
+    void AudioStream::Stop(){
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(!_source) return;
+
+        rewind(0);
+        _playing = false;
+    }
+
+    void AudioStream::Seek(float seconds){
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(!_source) return;
+
+        ALint state;
+        alGetSourcei(_source, AL_SOURCE_STATE, &state);
+
+        sf_count_t frame = std::clamp((sf_count_t)(seconds * _info.samplerate), (sf_count_t)0, _info.frames - 1);
+        rewind(frame);
+
+        if(state == AL_PLAYING) alSourcePlay(_source);
+    }
+
+}
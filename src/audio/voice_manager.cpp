@@ -0,0 +1,202 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <GLEP/audio/voice_manager.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace GLEP::Audio{
+
+    //Matches OpenAL's default inverse distance clamped model
+    static const float REFERENCE_DISTANCE = 1.0f;
+    static const int DEFAULT_DEVICE_LIMIT = 256;
+
+    struct RankedSource{
+        AudioSource* Source;
+        float Score;
+    };
+
+    struct VoicePool{
+        std::vector<AudioSource*> Sources;
+        std::vector<ALuint> Voices;
+        std::vector<ALuint> Free;
+        std::vector<RankedSource> Ranked;
+    };
+
+    //Never destroyed, sources held in globals may unregister after static destruction has started
+    static VoicePool& pool(){
+        static VoicePool* pool = new VoicePool();
+        return *pool;
+    }
+
+    int VoiceManager::_deviceLimit = DEFAULT_DEVICE_LIMIT;
+    unsigned int VoiceManager::_playOrder = 0;
+    VoiceStats VoiceManager::_stats;
+
+    int VoiceManager::MaxVoices = 0;
+    float VoiceManager::AudibleGain = 0.001f;
+    float VoiceManager::RealizedBias = 1.25f;
+
+    void VoiceManager::Initialize(ALCdevice* alDevice){
+        ALCint mono = 0, stereo = 0;
+        alcGetIntegerv(alDevice, ALC_MONO_SOURCES, 1, &mono);
+        alcGetIntegerv(alDevice, ALC_STEREO_SOURCES, 1, &stereo);
+
+        _deviceLimit = mono + stereo > 0 ? mono + stereo : DEFAULT_DEVICE_LIMIT;
+    }
+
+    void VoiceManager::Shutdown(){
+        VoicePool& voicePool = pool();
+
+        for(AudioSource* source : voicePool.Sources){
+            if(source->_alSource) release(source);
+        }
+
+        if(!voicePool.Voices.empty()) alDeleteSources((ALsizei)voicePool.Voices.size(), voicePool.Voices.data());
+        voicePool.Voices.clear();
+        voicePool.Free.clear();
+    }
+
+    VoiceStats VoiceManager::GetStats(){ return _stats; }
+
+    int VoiceManager::capacity(){
+        return MaxVoices > 0 ? std::min(MaxVoices, _deviceLimit) : _deviceLimit;
+    }
+
+    bool VoiceManager::acquire(ALuint& alSource){
+        VoicePool& voicePool = pool();
+
+        if(!voicePool.Free.empty()){
+            alSource = voicePool.Free.back();
+            voicePool.Free.pop_back();
+            return true;
+        }
+
+        if((int)voicePool.Voices.size() >= capacity()) return false;
+
+        //Sources are created as the pool fills, a device that runs out early lowers the limit
+        alGetError();
+        alGenSources(1, &alSource);
+        if(alGetError() != AL_NO_ERROR){
+            _deviceLimit = (int)voicePool.Voices.size();
+            Print(PrintCode::ERROR, "VOICE_MANAGER", "Device ran out of sources at " + std::to_string(_deviceLimit) + " voices.");
+            return false;
+        }
+
+        voicePool.Voices.push_back(alSource);
+        return true;
+    }
+
+    void VoiceManager::release(AudioSource* source){
+        pool().Free.push_back(source->virtualize());
+        _stats.Virtualizations++;
+    }
+
+    void VoiceManager::Register(AudioSource* source){
+        pool().Sources.push_back(source);
+    }
+
+    void VoiceManager::Unregister(AudioSource* source){
+        VoicePool& voicePool = pool();
+
+        if(source->_alSource) release(source);
+        voicePool.Sources.erase(std::remove(voicePool.Sources.begin(), voicePool.Sources.end(), source), voicePool.Sources.end());
+    }
+
+    void VoiceManager::Request(AudioSource* source){
+        ALuint alSource;
+        if(!acquire(alSource)){
+            //Sources that finished since the last update still hold their voice, reclaim one before giving up
+            VoicePool& voicePool = pool();
+            auto finished = std::find_if(voicePool.Sources.begin(), voicePool.Sources.end(), [](AudioSource* other){
+                return other->_alSource && other->GetState() != AudioSourceState::PLAYING;
+            });
+            if(finished == voicePool.Sources.end()) return;
+
+            release(*finished);
+            if(!acquire(alSource)) return;
+        }
+
+        source->realize(alSource);
+        _stats.Realizations++;
+    }
+
+    unsigned int VoiceManager::NextPlayOrder(){ return ++_playOrder; }
+
+    void VoiceManager::Update(glm::vec3 listenerPosition){
+        VoicePool& voicePool = pool();
+        std::vector<RankedSource>& ranked = voicePool.Ranked;
+        ranked.clear();
+
+        for(AudioSource* source : voicePool.Sources){
+            //Paused and finished sources don't need mixing
+            if(source->GetState() != AudioSourceState::PLAYING){
+                if(source->_alSource) release(source);
+                continue;
+            }
+
+            //OpenAL only positions mono sources, and relative sources follow the listener, so neither fades with listener distance
+            float audibility = source->_gain;
+            if(source->_channels == 1 && !source->_relative){
+                float distance = glm::length(source->_position - listenerPosition);
+                audibility *= REFERENCE_DISTANCE / std::max(distance, REFERENCE_DISTANCE);
+            }
+            if(audibility < AudibleGain){
+                if(source->_alSource) release(source);
+                continue;
+            }
+
+            //Sources that already have a voice keep it until clearly outranked, so near ties don't trade voices every update
+            ranked.push_back({source, source->_alSource ? audibility * RealizedBias : audibility});
+        }
+
+        std::sort(ranked.begin(), ranked.end(), [](const RankedSource& a, const RankedSource& b){
+            if(a.Source->_priority != b.Source->_priority) return a.Source->_priority > b.Source->_priority;
+            if(a.Score != b.Score) return a.Score > b.Score;
+            return a.Source->_playOrder < b.Source->_playOrder;
+        });
+
+        int voices = std::min(capacity(), (int)ranked.size());
+
+        //Free the voices of outranked sources before handing them out
+        for(int i = voices; i < (int)ranked.size(); i++){
+            if(ranked[i].Source->_alSource) release(ranked[i].Source);
+        }
+
+        for(int i = 0; i < voices; i++){
+            if(!ranked[i].Source->_alSource) Request(ranked[i].Source);
+        }
+
+        //Trim the pool if MaxVoices was lowered
+        while((int)voicePool.Voices.size() > capacity() && !voicePool.Free.empty()){
+            ALuint alSource = voicePool.Free.back();
+            voicePool.Free.pop_back();
+            alDeleteSources(1, &alSource);
+            voicePool.Voices.erase(std::find(voicePool.Voices.begin(), voicePool.Voices.end(), alSource));
+        }
+
+        _stats.Sources = (int)voicePool.Sources.size();
+        _stats.Voices = (int)voicePool.Voices.size();
+        _stats.Realized = 0;
+        for(const RankedSource& rankedSource : ranked){
+            if(rankedSource.Source->_alSource) _stats.Realized++;
+        }
+        _stats.Virtual = (int)ranked.size() - _stats.Realized;
+    }
+
+}
@@ -25,18 +25,12 @@ namespace GLEP::Control{
     }
 
     void InterpManager::Update(){
-        std::vector<std::shared_ptr<TypelessInterpSequence>> toBeRemoved;
-
         float time = Time::GetElapsedTimeF();
         float deltaTime = Time::GetDeltaTimeF();
-        for(auto& sequence : queue){
-            if(sequence->Update(time, deltaTime)){
-                toBeRemoved.push_back(sequence);
-            }
-        }
 
-        for(auto& sequence : toBeRemoved){
-            RemoveSequenceFromQueue(sequence);
-        }
+        //Finished sequences are compacted out in place rather than collected into a temporary list
+        queue.erase(std::remove_if(queue.begin(), queue.end(), [time, deltaTime](const std::shared_ptr<TypelessInterpSequence>& sequence){
+            return sequence->Update(time, deltaTime);
+        }), queue.end());
     }
 }
\ No newline at end of file
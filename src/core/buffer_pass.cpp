@@ -18,28 +18,179 @@
 #include <GLEP/core/buffer_pass.hpp>
 
 namespace GLEP {
+
+    //A per-pixel pass may only sample its source color at the current texel
+    static const std::regex TEXEL_SAMPLE("texture\\s*\\(\\s*uFramebuffer\\.color\\s*,\\s*v\\.uv\\s*\\)");
+
+    //Declarations every pass shader repeats, emitted once by a fused shader
+    static const std::regex SHARED_DECLARATIONS(
+        "#version[^\\n]*|out\\s+vec4\\s+FragColor\\s*;|in\\s+Vertex\\s+v\\s*;|uniform\\s+Framebuffer\\s+uFramebuffer\\s*;"
+        "|struct\\s+(?:Vertex|Framebuffer)\\s*\\{[^}]*\\}\\s*;"
+    );
+
+    static const char* FUSED_HEADER = R"(#version 330 core
+out vec4 FragColor;
+
+struct Vertex {
+    vec3 position;
+    vec3 normal;
+    vec2 uv;
+};
+
+in Vertex v;
+
+struct Framebuffer{
+    sampler2D color;
+    sampler2D depth;
+};
+
+uniform Framebuffer uFramebuffer;
+
+vec4 fusedColor;
+)";
+
+    //Uniforms the composer updates while the graph executes, kept as strings so setting them doesn't allocate
+    static const std::string TEXEL_SIZE_UNIFORM = "uMaterial.texelSize";
+    static const std::string SHARPNESS_UNIFORM = "uMaterial.sharpness";
+    static const std::string DIRECTION_UNIFORM = "uMaterial.direction";
+    static const std::string PREFILTER_UNIFORM = "uMaterial.prefilter";
+
+    static std::vector<std::string> declaredIdentifiers(const std::string& source){
+        static const std::regex structDeclaration("^struct\\s+(\\w+)");
+        static const std::regex uniformDeclaration("^uniform\\s+\\w+\\s+(\\w+)");
+        static const std::regex valueDeclaration("^(?:const\\s+)?\\w+\\s+(\\w+)\\s*[(=;\\[]");
+
+        //Top-level declarations are expected to start at the beginning of a line
+        std::vector<std::string> identifiers;
+        std::istringstream lines(source);
+        std::string line;
+        std::smatch match;
+        while(std::getline(lines, line)){
+            if(!std::regex_search(line, match, structDeclaration) && !std::regex_search(line, match, uniformDeclaration) && !std::regex_search(line, match, valueDeclaration))
+                continue;
+
+            if(std::find(identifiers.begin(), identifiers.end(), match[1].str()) == identifiers.end())
+                identifiers.push_back(match[1].str());
+        }
+
+        return identifiers;
+    }
+
+    static std::shared_ptr<Material> fusedMaterial(const std::vector<std::shared_ptr<BufferPass>>& passes){
+        std::string source = FUSED_HEADER;
+        std::string main = "\nvoid main(){\n    fusedColor = texture(uFramebuffer.color, v.uv);\n";
+        std::string name = "fused_pass(";
+        std::vector<std::shared_ptr<TypelessShaderUniform>> aliases;
+
+        for(int i = 0; i < passes.size(); i++){
+            std::shared_ptr<Material> material = passes[i]->GetMaterial();
+            std::string suffix = "_fused" + std::to_string(i);
+
+            //Each pass becomes a function reading the previous pass' result instead of the source
+            std::string pass = std::regex_replace(material->GetShader()->GetFsSource(), SHARED_DECLARATIONS, "");
+            pass = std::regex_replace(pass, TEXEL_SAMPLE, "fusedColor");
+            pass = std::regex_replace(pass, std::regex("\\n[ \\t]*(?:\\n[ \\t]*)+\\n"), "\n\n");
+
+            std::vector<std::string> identifiers = declaredIdentifiers(pass);
+            for(const std::string& identifier : identifiers)
+                pass = std::regex_replace(pass, std::regex("\\b" + identifier + "\\b"), identifier + suffix);
+
+            source += "\n//" + passes[i]->GetName() + "\n" + pass + "\n";
+            main += "    main" + suffix + "();\n";
+            if(i < passes.size() - 1)
+                main += "    fusedColor = FragColor;\n";
+            name += (i > 0 ? ", " : "") + passes[i]->GetName();
+
+            for(const std::shared_ptr<TypelessShaderUniform>& uniform : material->GetUniforms()){
+                std::string identifier = uniform->Name.substr(0, uniform->Name.find_first_of(".["));
+                if(std::find(identifiers.begin(), identifiers.end(), identifier) == identifiers.end())
+                    continue;
+
+                aliases.push_back(std::make_shared<ShaderUniformAlias>(identifier + suffix + uniform->Name.substr(identifier.size()), uniform));
+            }
+        }
+        source += main + "}\n";
+        name += ")";
+
+        std::shared_ptr<Shader> shader = Shader::FromSource(passes[0]->GetMaterial()->GetShader()->GetVsSource(), source, name);
+        std::shared_ptr<Material> result = std::make_shared<Material>(shader);
+        for(const std::shared_ptr<TypelessShaderUniform>& alias : aliases)
+            result->AddUniform(alias);
+
+        return result;
+    }
     
+    //Normalized weights for each texel distance up to the radius, with pairs of texels past the center merged into one bilinear tap between them
+    static int blurTaps(float radius, BlurType type, float* weights, float* offsets){
+        float texels[BlurPass::MAX_RADIUS + 2];
+        int extent = (int)glm::ceil(radius);
+        float sigma = glm::max(radius / 3.0f, 0.0001f);
+
+        float sum = 0.0f;
+        for(int i = 0; i <= extent; i++){
+            if(type == BlurType::GAUSSIAN) texels[i] = glm::exp(-(float)(i * i) / (2.0f * sigma * sigma));
+            else texels[i] = glm::clamp(radius - i + 1.0f, 0.0f, 1.0f);
+
+            sum += i == 0 ? texels[i] : texels[i] * 2.0f;
+        }
+        texels[extent + 1] = 0.0f;
+
+        weights[0] = texels[0] / sum;
+        offsets[0] = 0.0f;
+
+        int taps = 1;
+        for(int i = 1; i <= extent; i += 2){
+            float weight = texels[i] + texels[i + 1];
+            weights[taps] = weight / sum;
+            offsets[taps] = weight > 0.0f ? (i * texels[i] + (i + 1) * texels[i + 1]) / weight : (float)i;
+            taps++;
+        }
+
+        return taps;
+    }
+
     BufferPass::BufferPass(std::shared_ptr<Material> material){
         std::shared_ptr<Geometry> geometry = std::make_shared<PlaneGeometry>(2.0f, 2.0f);
         _mesh = std::make_shared<Mesh>(geometry, material);
     }
 
-    void BufferPass::InitializeBuffer(glm::vec2 resolution){
-        _framebuffer = std::make_shared<Framebuffer>(resolution);
-        _mesh->MaterialData->AddUniform<std::shared_ptr<Framebuffer>>("uFramebuffer", _framebuffer);
-    }
-
     std::shared_ptr<Framebuffer> BufferPass::GetFramebuffer(){ return _framebuffer; }
     std::shared_ptr<Material> BufferPass::GetMaterial(){ return _mesh->MaterialData; }
     std::string BufferPass::GetName(){ return _name; }
 
-    void BufferPass::Bind(){
-        _framebuffer->Bind();
+    bool BufferPass::GetReadsDepth(){
+        //Checked in the source, as some drivers keep every member of a struct uniform active
+        return _mesh->MaterialData->GetShader()->GetFsSource().find("uFramebuffer.depth") != std::string::npos;
+    }
+
+    bool BufferPass::GetIsPerPixel(){
+        if(_multiPass) return false;
+
+        const std::string& source = _mesh->MaterialData->GetShader()->GetFsSource();
+        std::string remaining = std::regex_replace(source, TEXEL_SAMPLE, "");
+
+        return remaining.find("uFramebuffer.color") == std::string::npos && source.find("FragColor") != std::string::npos;
+    }
+
+    void BufferPass::SetSource(const std::shared_ptr<Framebuffer>& framebuffer, const std::shared_ptr<Framebuffer>& depthFramebuffer){
+        if(!_framebuffer && framebuffer)
+            _mesh->MaterialData->AddUniform<std::shared_ptr<Framebuffer>>("uFramebuffer", framebuffer);
+        else if(_framebuffer != framebuffer)
+            _mesh->MaterialData->SetUniformValue<std::shared_ptr<Framebuffer>>("uFramebuffer", framebuffer);
+
+        _framebuffer = framebuffer;
+        _depthFramebuffer = depthFramebuffer;
     }
 
     void BufferPass::Render() {
         _mesh->MaterialData->Use();
 
+        //Depth can come from a different target than color, e.g. the scene depth for a pass further down the chain
+        if(_depthFramebuffer){
+            glActiveTexture(GL_TEXTURE0 + 5);
+            glBindTexture(GL_TEXTURE_2D, _depthFramebuffer->GetDepthBufferID());
+        }
+
         _mesh->MaterialData->SetUniform("time", Time::GetElapsedTimeF());
         _mesh->MaterialData->SetUniform("deltaTime", Time::GetDeltaTimeF());
 
@@ -69,6 +220,12 @@ namespace GLEP {
             result = GrainPass::FromJson(data["material_data"]);
         } else if (type == "fog_pass"){
             result = FogPass::FromJson(data["material_data"]);
+        } else if (type == "upsample_pass"){
+            result = UpsamplePass::FromJson(data["material_data"]);
+        } else if (type == "blur_pass"){
+            result = BlurPass::FromJson(data["material_data"]);
+        } else if (type == "bloom_pass"){
+            result = BloomPass::FromJson(data["material_data"]);
         } else {
             Print(PrintCode::ERROR, "BUFFER_PASS", "Unknown Buffer Pass type: " + type);
         }
@@ -188,108 +345,396 @@ namespace GLEP {
         );
     }
 
-    BufferPassComposer::BufferPassComposer(glm::vec2 resolution){
-        _resolution = resolution;
+    UpsamplePass::UpsamplePass(float sharpness)
+    : BufferPass(
+        std::make_shared<Material>(
+            File::GLEP_SHADERS_PATH / "post" / "defaultPass.vs",
+            File::GLEP_SHADERS_PATH / "post" / "upsamplePass.fs"
+        )
+    ){
+        _name = "upsample_pass";
 
-        initialize();
+        GetMaterial()->AddUniform<glm::vec2>(TEXEL_SIZE_UNIFORM, glm::vec2(0.0f));
+        GetMaterial()->AddUniform<float>(SHARPNESS_UNIFORM, sharpness);
     }
 
-    void BufferPassComposer::initialize(){
-        _objectPass = std::make_shared<RenderPass>();
-        _objectPass->InitializeBuffer(_resolution);
-        _skyboxPass = std::make_shared<RenderPass>();
-        _skyboxPass->InitializeBuffer(_resolution);
-        _renderPass = std::make_shared<RenderPass>();
-        _renderPass->InitializeBuffer(_resolution);
+    std::shared_ptr<UpsamplePass> UpsamplePass::FromJson(const json& data){
+        return std::make_shared<UpsamplePass>(data["uniforms"]["uMaterial.sharpness"]);
     }
 
-    std::shared_ptr<FogPass> BufferPassComposer::GetFogPass(){ return _fogPass;}
-    std::vector<std::shared_ptr<BufferPass>> BufferPassComposer::GetBufferPasses(){ return _bufferPasses; }
-    glm::vec2 BufferPassComposer::GetResolution(){ return _resolution; }
+    BlurPass::BlurPass(float radius, BlurType type)
+    : BufferPass(
+        std::make_shared<Material>(
+            File::GLEP_SHADERS_PATH / "post" / "defaultPass.vs",
+            File::GLEP_SHADERS_PATH / "post" / "blurPass.fs"
+        )
+    ){
+        _name = "blur_pass";
+        _multiPass = true;
+        _radius = glm::clamp(radius, 0.0f, (float)MAX_RADIUS);
+        _type = type;
 
-    void BufferPassComposer::SetResolution(glm::vec2 resolution){
-        _resolution = resolution;
+        GetMaterial()->AddUniform<float>("uMaterial.radius", _radius);
+        GetMaterial()->AddUniform<int>("uMaterial.type", (int)_type);
+        GetMaterial()->AddUniform<glm::vec2>(DIRECTION_UNIFORM, glm::vec2(0.0f), true);
+        GetMaterial()->AddUniform<int>("uMaterial.taps", 1, true);
 
-        _objectPass->InitializeBuffer(_resolution);
-        _skyboxPass->InitializeBuffer(_resolution);
-        _renderPass->InitializeBuffer(_resolution);
+        updateWeights();
+    }
 
-        if(_fogPass){
-            _fogPass->InitializeBuffer(_resolution);
+    float BlurPass::GetRadius(){ return _radius; }
+    BlurType BlurPass::GetType(){ return _type; }
+
+    void BlurPass::SetRadius(float radius){
+        _radius = glm::clamp(radius, 0.0f, (float)MAX_RADIUS);
+        updateWeights();
+    }
+
+    void BlurPass::SetType(BlurType type){
+        _type = type;
+        updateWeights();
+    }
+
+    void BlurPass::updateWeights(){
+        float weights[MAX_TAPS];
+        float offsets[MAX_TAPS];
+        int taps = blurTaps(_radius, _type, weights, offsets);
+
+        std::shared_ptr<Material> material = GetMaterial();
+        material->SetUniformValue<float>("uMaterial.radius", _radius);
+        material->SetUniformValue<int>("uMaterial.type", (int)_type);
+        material->SetUniformValue<int>("uMaterial.taps", taps);
+
+        //Tap uniforms are only added as the radius grows, unused ones past the tap count are ignored by the shader
+        for(int i = 0; i < taps; i++){
+            std::string index = "[" + std::to_string(i) + "]";
+
+            if(!material->SetUniformValue<float>("uMaterial.weights" + index, weights[i]))
+                material->AddUniform<float>("uMaterial.weights" + index, weights[i], true);
+
+            if(!material->SetUniformValue<float>("uMaterial.offsets" + index, offsets[i]))
+                material->AddUniform<float>("uMaterial.offsets" + index, offsets[i], true);
         }
+    }
+
+    std::shared_ptr<BlurPass> BlurPass::FromJson(const json& data){
+        return std::make_shared<BlurPass>(
+            data["uniforms"]["uMaterial.radius"],
+            (BlurType)(int)data["uniforms"]["uMaterial.type"]
+        );
+    }
+
+    BloomPass::BloomPass(float threshold, float intensity, int levels)
+    : BufferPass(
+        std::make_shared<Material>(
+            File::GLEP_SHADERS_PATH / "post" / "defaultPass.vs",
+            File::GLEP_SHADERS_PATH / "post" / "bloomPass.fs"
+        )
+    ){
+        _name = "bloom_pass";
+        _multiPass = true;
+        _levels = glm::max(levels, 1);
+
+        GetMaterial()->AddUniform<float>("uMaterial.threshold", threshold);
+        GetMaterial()->AddUniform<float>("uMaterial.intensity", intensity);
+        GetMaterial()->AddUniform<int>("uMaterial.levels", _levels);
+        GetMaterial()->AddUniform<int>("uMaterial.bloom", 6, true);
+
+        _downsamplePass = std::make_shared<BufferPass>(
+            std::make_shared<Material>(
+                File::GLEP_SHADERS_PATH / "post" / "defaultPass.vs",
+                File::GLEP_SHADERS_PATH / "post" / "bloomDownsample.fs"
+            )
+        );
+
+        //The threshold is serialized with the bloom pass and read by the downsample shader through an alias
+        _downsamplePass->GetMaterial()->AddUniform(std::make_shared<ShaderUniformAlias>("uMaterial.threshold", GetMaterial()->GetUniform<float>("uMaterial.threshold")));
+        _downsamplePass->GetMaterial()->AddUniform<glm::vec2>(TEXEL_SIZE_UNIFORM, glm::vec2(0.0f), true);
+        _downsamplePass->GetMaterial()->AddUniform<bool>(PREFILTER_UNIFORM, false, true);
 
-        for(std::shared_ptr<BufferPass> p : _bufferPasses){
-            p->InitializeBuffer(_resolution);
+        _upsamplePass = std::make_shared<BufferPass>(
+            std::make_shared<Material>(
+                File::GLEP_SHADERS_PATH / "post" / "defaultPass.vs",
+                File::GLEP_SHADERS_PATH / "post" / "bloomUpsample.fs"
+            )
+        );
+        _upsamplePass->GetMaterial()->AddUniform<glm::vec2>(TEXEL_SIZE_UNIFORM, glm::vec2(0.0f), true);
+    }
+
+    int BloomPass::GetLevels(){ return _levels; }
+    std::shared_ptr<BufferPass> BloomPass::GetDownsamplePass(){ return _downsamplePass; }
+    std::shared_ptr<BufferPass> BloomPass::GetUpsamplePass(){ return _upsamplePass; }
+
+    std::shared_ptr<BloomPass> BloomPass::FromJson(const json& data){
+        return std::make_shared<BloomPass>(
+            data["uniforms"]["uMaterial.threshold"],
+            data["uniforms"]["uMaterial.intensity"],
+            data["uniforms"]["uMaterial.levels"]
+        );
+    }
+
+    FusedPass::FusedPass(const std::vector<std::shared_ptr<BufferPass>>& passes)
+    : BufferPass(fusedMaterial(passes)){
+        _name = "fused_pass";
+        _passes = passes;
+    }
+
+    std::vector<std::shared_ptr<BufferPass>> FusedPass::GetPasses(){ return _passes; }
+
+    BufferPassComposer::BufferPassComposer(glm::vec2 resolution){
+        _resolution = resolution;
+        _copyPass = std::make_shared<RenderPass>();
+        _upsamplePass = std::make_shared<UpsamplePass>(UpsampleSharpness);
+    }
+
+    std::shared_ptr<FogPass> BufferPassComposer::GetFogPass(){ return _fogPass;}
+    std::vector<std::shared_ptr<BufferPass>> BufferPassComposer::GetBufferPasses(){ return _bufferPasses; }
+
+    std::vector<std::shared_ptr<BufferPass>> BufferPassComposer::GetRenderedPasses(){
+        updateChain();
+        return _chain;
+    }
+    bool BufferPassComposer::GetReadsDepth(){
+        if(_fogPass) return true;
+
+        for(const std::shared_ptr<BufferPass>& pass : _bufferPasses){
+            if(pass->GetReadsDepth()) return true;
         }
+
+        return false;
+    }
+
+    glm::vec2 BufferPassComposer::GetResolution(){ return _resolution; }
+    unsigned int BufferPassComposer::GetRevision(){ return _revision; }
+
+    void BufferPassComposer::SetResolution(glm::vec2 resolution){
+        _resolution = resolution;
+        _revision++;
     }
 
     void BufferPassComposer::Add(std::shared_ptr<BufferPass> pass){
-        pass->InitializeBuffer(_resolution);
         _bufferPasses.push_back(pass);
+        _chainDirty = true;
+        _revision++;
     }
 
     void BufferPassComposer::Add(std::shared_ptr<FogPass> fogPass){
-        fogPass->InitializeBuffer(_resolution);
         _fogPass = fogPass;
+        _revision++;
     }
 
-    void BufferPassComposer::NewFrame(){
-        if(_fogPass){
-            _objectPass->Bind();
-        } else {
-            _renderPass->Bind();
+    void BufferPassComposer::updateChain(){
+        if(!_chainDirty && _chainFused == FusePasses) return;
+
+        _chain.clear();
+        _chainDirty = false;
+        _chainFused = FusePasses;
+
+        if(!FusePasses){
+            _chain = _bufferPasses;
+            return;
         }
-    }
 
-    void BufferPassComposer::PreSkybox(){
-        if(_fogPass){
-            _skyboxPass->Bind();
+        //Runs of consecutive per-pixel passes are drawn as one, neighbourhood passes stay separate
+        std::vector<std::shared_ptr<BufferPass>> run;
+        auto endRun = [&](){
+            if(run.size() > 1) _chain.push_back(std::make_shared<FusedPass>(run));
+            else if(run.size() == 1) _chain.push_back(run[0]);
+            run.clear();
+        };
+
+        for(const std::shared_ptr<BufferPass>& pass : _bufferPasses){
+            if(!pass->GetIsPerPixel()){
+                endRun();
+                _chain.push_back(pass);
+                continue;
+            }
+
+            if(!run.empty() && run[0]->GetMaterial()->GetShader()->GetVsSource() != pass->GetMaterial()->GetShader()->GetVsSource())
+                endRun();
+
+            run.push_back(pass);
         }
+        endRun();
     }
 
-    void BufferPassComposer::Render(){
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    FramebufferDesc BufferPassComposer::targetDesc(){
+        //Full-screen passes never depth test, so intermediate targets only carry color
+        FramebufferDesc desc;
+        desc.Color = ColorFormat;
+        desc.Depth = FramebufferDepth::NONE;
+        return desc;
+    }
+
+    void BufferPassComposer::beginPass(){
         glDisable(GL_DEPTH_TEST);
 
+        //Pooled targets are shared with other passes, so stale content is cleared before drawing
         glClearColor(ClearColor.r, ClearColor.g, ClearColor.b, ClearColor.a);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
 
-        if(_fogPass){
-            _fogPass->Bind();
-            _fogPass->GetFramebuffer()->SetDepthBufferID(_objectPass->GetFramebuffer()->GetDepthBufferID());
+    void BufferPassComposer::endPass(){
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    void BufferPassComposer::renderPass(const std::shared_ptr<BufferPass>& pass, const std::shared_ptr<Framebuffer>& source, const std::shared_ptr<Framebuffer>& depthSource){
+        pass->SetSource(source, depthSource);
+        pass->Render();
+    }
+
+    void BufferPassComposer::addBlurPasses(RenderGraph& graph, const std::shared_ptr<BlurPass>& blur, RenderGraphResource source, RenderGraphResource target){
+        //Two 1D passes cost O(r) fetches per pixel rather than O(r^2) for a single 2D kernel
+        RenderGraphResource horizontal = graph.CreateTarget("blur_horizontal", _resolution, targetDesc());
+
+        graph.AddPass("blur_horizontal", {source}, horizontal, [this, blur, source](RenderGraph& g){
+            const std::shared_ptr<Framebuffer>& framebuffer = g.GetFramebuffer(source);
+            blur->GetMaterial()->SetUniformValue<glm::vec2>(DIRECTION_UNIFORM, glm::vec2(1.0f / framebuffer->GetWidth(), 0.0f));
 
-            _objectPass->Render();
+            beginPass();
+            renderPass(blur, framebuffer, nullptr);
+            endPass();
+        });
 
-            _renderPass->Bind();
-            _renderPass->GetFramebuffer()->SetDepthBufferID(_objectPass->GetFramebuffer()->GetDepthBufferID());
+        graph.AddPass("blur_vertical", {horizontal}, target, [this, blur, horizontal](RenderGraph& g){
+            const std::shared_ptr<Framebuffer>& framebuffer = g.GetFramebuffer(horizontal);
+            blur->GetMaterial()->SetUniformValue<glm::vec2>(DIRECTION_UNIFORM, glm::vec2(0.0f, 1.0f / framebuffer->GetHeight()));
 
-            _skyboxPass->Render();
-            _fogPass->Render();
+            beginPass();
+            renderPass(blur, framebuffer, nullptr);
+            endPass();
+        });
+    }
+
+    void BufferPassComposer::addBloomPasses(RenderGraph& graph, const std::shared_ptr<BloomPass>& bloom, RenderGraphResource source, RenderGraphResource target){
+        //Each level halves the resolution, so the blur widens exponentially while the cost of each level shrinks by four
+        std::vector<RenderGraphResource> mips;
+        glm::vec2 resolution = _resolution;
+        RenderGraphResource previous = source;
+
+        for(int i = 0; i < bloom->GetLevels(); i++){
+            resolution = glm::max(glm::floor(resolution * 0.5f), glm::vec2(1.0f));
+            if(i > 0 && glm::min(resolution.x, resolution.y) < 2.0f) break;
+
+            //Bloom accumulates across levels, so mips keep float precision at the same size as RGBA8
+            FramebufferDesc mipDesc = targetDesc();
+            mipDesc.Color = FramebufferColor::R11G11B10F;
+
+            RenderGraphResource mip = graph.CreateTarget("bloom_mip_" + std::to_string(i), resolution, mipDesc);
+            bool prefilter = i == 0;
 
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            graph.AddPass("bloom_downsample", {previous}, mip, [this, bloom, previous, prefilter](RenderGraph& g){
+                const std::shared_ptr<BufferPass>& downsample = bloom->GetDownsamplePass();
+                const std::shared_ptr<Framebuffer>& framebuffer = g.GetFramebuffer(previous);
+                downsample->GetMaterial()->SetUniformValue<glm::vec2>(TEXEL_SIZE_UNIFORM, glm::vec2(1.0f / framebuffer->GetWidth(), 1.0f / framebuffer->GetHeight()));
+                downsample->GetMaterial()->SetUniformValue<bool>(PREFILTER_UNIFORM, prefilter);
+
+                beginPass();
+                renderPass(downsample, framebuffer, nullptr);
+                endPass();
+            });
+
+            mips.push_back(mip);
+            previous = mip;
         }
 
-        if(_bufferPasses.size() > 0){
-            _bufferPasses[0]->Bind();
-            _bufferPasses[0]->GetFramebuffer()->SetDepthBufferID(_renderPass->GetFramebuffer()->GetDepthBufferID());
+        //Walking back up, each level is blurred into the one above it, which keeps its own downsampled content
+        for(int i = (int)mips.size() - 2; i >= 0; i--){
+            RenderGraphResource lower = mips[i + 1];
+
+            graph.AddPass("bloom_upsample", {lower, mips[i]}, mips[i], [this, bloom, lower](RenderGraph& g){
+                const std::shared_ptr<BufferPass>& upsample = bloom->GetUpsamplePass();
+                const std::shared_ptr<Framebuffer>& framebuffer = g.GetFramebuffer(lower);
+                upsample->GetMaterial()->SetUniformValue<glm::vec2>(TEXEL_SIZE_UNIFORM, glm::vec2(1.0f / framebuffer->GetWidth(), 1.0f / framebuffer->GetHeight()));
+
+                glDisable(GL_DEPTH_TEST);
+                glEnable(GL_BLEND);
+                glBlendFunc(GL_ONE, GL_ONE);
+
+                renderPass(upsample, framebuffer, nullptr);
+
+                glDisable(GL_BLEND);
+                endPass();
+            });
         }
 
-        _renderPass->Render();
-        
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        RenderGraphResource blurred = mips[0];
+        graph.AddPass(bloom->GetName(), {source, blurred}, target, [this, bloom, source, blurred](RenderGraph& g){
+            beginPass();
 
-        for(int i = 0; i < _bufferPasses.size(); i++){
-            if(i < _bufferPasses.size() - 1){
-                _bufferPasses[i+1]->Bind();
-                _bufferPasses[i+1]->GetFramebuffer()->SetDepthBufferID(_renderPass->GetFramebuffer()->GetDepthBufferID());
-            } 
+            glActiveTexture(GL_TEXTURE0 + 6);
+            glBindTexture(GL_TEXTURE_2D, g.GetFramebuffer(blurred)->GetColorBufferID());
+            renderPass(bloom, g.GetFramebuffer(source), nullptr);
+
+            endPass();
+        });
+    }
 
-            _bufferPasses[i]->Render();
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    void BufferPassComposer::AddPasses(RenderGraph& graph, RenderGraphResource objects, RenderGraphResource skybox, RenderGraphResource output){
+        RenderGraphResource scene = objects;
+
+        if(_fogPass){
+            scene = graph.CreateTarget("fog_pass", _resolution, targetDesc());
+            graph.AddPass("fog_pass", {objects, skybox}, scene, [this, objects, skybox](RenderGraph& g){
+                beginPass();
+                renderPass(_copyPass, g.GetFramebuffer(skybox), nullptr);
+                renderPass(_fogPass, g.GetFramebuffer(objects), nullptr);
+                endPass();
+            });
         }
 
-        glEnable(GL_DEPTH_TEST);
+        updateChain();
+
+        //A composer rendering below the output resolution finishes with an upsample instead of writing the output directly
+        glm::vec2 outputResolution = graph.GetResolution(output);
+        bool upsample = outputResolution.x > 0.0f && outputResolution != _resolution;
+
+        //Each pass only needs its source until it has drawn, so the chain alternates between two pooled targets
+        RenderGraphResource source = scene;
+        for(int i = 0; i < _chain.size(); i++){
+            std::shared_ptr<BufferPass> pass = _chain[i];
+            bool last = i == _chain.size() - 1;
+            RenderGraphResource target = last && !upsample ? output : graph.CreateTarget(pass->GetName(), _resolution, targetDesc());
+
+            //Multi-pass effects add their own intermediate targets between source and target
+            if(pass->GetName() == "blur_pass"){
+                addBlurPasses(graph, std::static_pointer_cast<BlurPass>(pass), source, target);
+            } else if(pass->GetName() == "bloom_pass"){
+                addBloomPasses(graph, std::static_pointer_cast<BloomPass>(pass), source, target);
+            } else {
+                //The scene depth is only kept alive for passes that sample it
+                bool readsDepth = pass->GetReadsDepth();
+                std::vector<RenderGraphResource> reads = {source};
+                if(readsDepth && source != objects)
+                    reads.push_back(objects);
+
+                graph.AddPass(pass->GetName(), reads, target, [this, pass, source, objects, readsDepth](RenderGraph& g){
+                    beginPass();
+                    renderPass(pass, g.GetFramebuffer(source), readsDepth ? g.GetFramebuffer(objects) : nullptr);
+                    endPass();
+                });
+            }
 
+            source = target;
+        }
+
+        if(upsample){
+            graph.AddPass("upsample_pass", {source}, output, [this, source](RenderGraph& g){
+                const std::shared_ptr<Framebuffer>& framebuffer = g.GetFramebuffer(source);
+                _upsamplePass->GetMaterial()->SetUniformValue<glm::vec2>(TEXEL_SIZE_UNIFORM, glm::vec2(1.0f / framebuffer->GetWidth(), 1.0f / framebuffer->GetHeight()));
+                _upsamplePass->GetMaterial()->SetUniformValue<float>(SHARPNESS_UNIFORM, UpsampleSharpness);
+
+                beginPass();
+                renderPass(_upsamplePass, framebuffer, nullptr);
+                endPass();
+            });
+        } else if(_chain.empty()){
+            graph.AddPass("render_pass", {scene}, output, [this, scene](RenderGraph& g){
+                beginPass();
+                renderPass(_copyPass, g.GetFramebuffer(scene), nullptr);
+                endPass();
+            });
+        }
     }
 
     json BufferPassComposer::ToJson(){
@@ -306,6 +751,11 @@ namespace GLEP {
         if(_fogPass)
             j["fog_pass"] = _fogPass->ToJson();
 
+        j["fuse_passes"] = FusePasses;
+        j["upsample_sharpness"] = UpsampleSharpness;
+        j["color_format"] = (int)ColorFormat;
+        j["samples"] = Samples;
+
         return j;
     }
 
@@ -321,6 +771,18 @@ namespace GLEP {
         if(!data["fog_pass"].is_null())
             result->Add(FogPass::FromJson(data["fog_pass"]["material_data"]));
 
+        if(data.contains("fuse_passes"))
+            result->FusePasses = data["fuse_passes"];
+
+        if(data.contains("upsample_sharpness"))
+            result->UpsampleSharpness = data["upsample_sharpness"];
+
+        if(data.contains("color_format"))
+            result->ColorFormat = (FramebufferColor)(int)data["color_format"];
+
+        if(data.contains("samples"))
+            result->Samples = data["samples"];
+
         return result;
     }
 }
\ No newline at end of file
@@ -0,0 +1,473 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <GLEP/core/bvh.hpp>
+
+#include <algorithm>
+
+namespace GLEP {
+
+    SceneBVH::SceneBVH(){}
+
+    int SceneBVH::GetNodeCount(){ return (int)(_nodes.size() - _freeNodes.size()); }
+
+    AABB SceneBVH::GetRootBounds(){
+        if(_root < 0) return AABB();
+        return _nodes[_root].Bounds;
+    }
+
+    const AABB* SceneBVH::GetBounds(SceneObject* object){
+        auto it = _subtreeBounds.find(object);
+        if(it == _subtreeBounds.end()) return nullptr;
+        return &it->second;
+    }
+
+    int SceneBVH::allocateNode(){
+        if(!_freeNodes.empty()){
+            int index = _freeNodes.back();
+            _freeNodes.pop_back();
+            _nodes[index] = Node();
+            return index;
+        }
+
+        _nodes.push_back(Node());
+        return (int)_nodes.size() - 1;
+    }
+
+    void SceneBVH::freeNode(int index){
+        _nodes[index] = Node();
+        _freeNodes.push_back(index);
+    }
+
+    AABB SceneBVH::computeBounds(SceneObject* object){
+        AABB local;
+        AABB own;
+        if(object->GetLocalBounds(local)){
+            own = local.Transform(object->GetModelMatrix());
+        } else {
+            glm::vec3 position = object->GetWorldPosition();
+            own = AABB(position, position);
+        }
+        _ownBounds[object] = own;
+
+        AABB subtree = own;
+        for(std::shared_ptr<SceneObject>& child : object->GetChildren()){
+            if(_leaves.count(child.get())) continue;
+            subtree.Expand(computeBounds(child.get()));
+        }
+        _subtreeBounds[object] = subtree;
+
+        return subtree;
+    }
+
+    void SceneBVH::forgetBounds(SceneObject* object){
+        _ownBounds.erase(object);
+        _subtreeBounds.erase(object);
+
+        for(std::shared_ptr<SceneObject>& child : object->GetChildren()){
+            if(_leaves.count(child.get())) continue;
+            forgetBounds(child.get());
+        }
+    }
+
+    unsigned int SceneBVH::revisionOf(SceneObject* object){
+        //Revisions only count up, so any change below this object changes the result
+        unsigned int revision = object->GetTransformRevision() * 31u + object->GetBoundsRevision();
+        for(std::shared_ptr<SceneObject>& child : object->GetChildren()){
+            revision = revision * 31u + revisionOf(child.get());
+        }
+
+        return revision;
+    }
+
+    bool SceneBVH::refitLeaf(int leaf, unsigned int revision){
+        _nodes[leaf].Revision = revision;
+
+        AABB bounds = computeBounds(_nodes[leaf].Object);
+        if(bounds == _nodes[leaf].Bounds) return false;
+
+        _nodes[leaf].Bounds = bounds;
+        refitFrom(_nodes[leaf].Parent);
+        return true;
+    }
+
+    void SceneBVH::refitOwner(SceneObject* object){
+        //The nearest ancestor with a leaf covers this object's bounds in its own
+        for(SceneObject* parent = object->Parent.get(); parent; parent = parent->Parent.get()){
+            auto it = _leaves.find(parent);
+            if(it == _leaves.end()) continue;
+
+            refitLeaf(it->second, revisionOf(parent));
+            return;
+        }
+    }
+
+    void SceneBVH::Clear(){
+        _nodes.clear();
+        _freeNodes.clear();
+        _root = -1;
+        _leaves.clear();
+        _ownBounds.clear();
+        _subtreeBounds.clear();
+    }
+
+    void SceneBVH::Build(const std::vector<std::shared_ptr<SceneObject>>& objects){
+        Clear();
+        if(objects.empty()) return;
+
+        //Register every leaf first so children that are also scene objects aren't counted twice
+        std::vector<int> leaves;
+        leaves.reserve(objects.size());
+        for(const std::shared_ptr<SceneObject>& o : objects){
+            int leaf = allocateNode();
+            _nodes[leaf].Object = o.get();
+            _leaves[o.get()] = leaf;
+            leaves.push_back(leaf);
+        }
+
+        for(int leaf : leaves){
+            _nodes[leaf].Revision = revisionOf(_nodes[leaf].Object);
+            _nodes[leaf].Bounds = computeBounds(_nodes[leaf].Object);
+        }
+
+        _root = buildRecursive(leaves, 0, (int)leaves.size());
+        _nodes[_root].Parent = -1;
+    }
+
+    int SceneBVH::buildRecursive(std::vector<int>& leaves, int begin, int end){
+        if(end - begin == 1) return leaves[begin];
+
+        AABB bounds;
+        AABB centroidBounds;
+        for(int i = begin; i < end; i++){
+            bounds.Expand(_nodes[leaves[i]].Bounds);
+            centroidBounds.Expand(_nodes[leaves[i]].Bounds.GetCenter());
+        }
+
+        glm::vec3 extent = centroidBounds.Max - centroidBounds.Min;
+        int axis = 0;
+        if(extent.y > extent[axis]) axis = 1;
+        if(extent.z > extent[axis]) axis = 2;
+
+        int mid = (begin + end) / 2;
+
+        if(extent[axis] > 0.0f){
+            const int BIN_COUNT = 12;
+            AABB binBounds[BIN_COUNT];
+            int binCounts[BIN_COUNT] = {};
+
+            float axisMin = centroidBounds.Min[axis];
+            float scale = BIN_COUNT / extent[axis];
+            auto binOf = [&](int leaf){
+                int bin = (int)((_nodes[leaf].Bounds.GetCenter()[axis] - axisMin) * scale);
+                return std::min(bin, BIN_COUNT - 1);
+            };
+
+            for(int i = begin; i < end; i++){
+                int bin = binOf(leaves[i]);
+                binCounts[bin]++;
+                binBounds[bin].Expand(_nodes[leaves[i]].Bounds);
+            }
+
+            //Sweep from the right to get the area and count of every right-hand split
+            float rightArea[BIN_COUNT];
+            int rightCount[BIN_COUNT];
+            AABB accumulated;
+            int count = 0;
+            for(int i = BIN_COUNT - 1; i > 0; i--){
+                accumulated.Expand(binBounds[i]);
+                count += binCounts[i];
+                rightArea[i] = accumulated.GetSurfaceArea();
+                rightCount[i] = count;
+            }
+
+            float bestCost = FLT_MAX;
+            int bestSplit = -1;
+            accumulated = AABB();
+            count = 0;
+            for(int i = 1; i < BIN_COUNT; i++){
+                accumulated.Expand(binBounds[i - 1]);
+                count += binCounts[i - 1];
+                if(count == 0 || rightCount[i] == 0) continue;
+
+                float cost = accumulated.GetSurfaceArea() * count + rightArea[i] * rightCount[i];
+                if(cost < bestCost){
+                    bestCost = cost;
+                    bestSplit = i;
+                }
+            }
+
+            if(bestSplit > 0){
+                int* split = std::partition(leaves.data() + begin, leaves.data() + end, [&](int leaf){
+                    return binOf(leaf) < bestSplit;
+                });
+                mid = (int)(split - leaves.data());
+            }
+        }
+
+        if(mid == begin || mid == end){
+            mid = (begin + end) / 2;
+            std::nth_element(leaves.begin() + begin, leaves.begin() + mid, leaves.begin() + end, [&](int a, int b){
+                return _nodes[a].Bounds.GetCenter()[axis] < _nodes[b].Bounds.GetCenter()[axis];
+            });
+        }
+
+        int left = buildRecursive(leaves, begin, mid);
+        int right = buildRecursive(leaves, mid, end);
+
+        int node = allocateNode();
+        _nodes[node].Left = left;
+        _nodes[node].Right = right;
+        _nodes[node].Bounds = bounds;
+        _nodes[left].Parent = node;
+        _nodes[right].Parent = node;
+
+        return node;
+    }
+
+    void SceneBVH::Insert(SceneObject* object){
+        if(!object || _leaves.count(object)) return;
+
+        int leaf = allocateNode();
+        _nodes[leaf].Object = object;
+        _leaves[object] = leaf;
+
+        _nodes[leaf].Revision = revisionOf(object);
+        _nodes[leaf].Bounds = computeBounds(object);
+
+        //If this object was already covered as a child of another leaf, that leaf shrinks
+        refitOwner(object);
+
+        insertLeaf(leaf);
+    }
+
+    void SceneBVH::Remove(SceneObject* object){
+        auto it = _leaves.find(object);
+        if(it == _leaves.end()) return;
+
+        int leaf = it->second;
+        removeLeaf(leaf);
+        forgetBounds(object);
+        _leaves.erase(it);
+        freeNode(leaf);
+
+        //A parent that still has a leaf covers this object again
+        refitOwner(object);
+    }
+
+    int SceneBVH::Refit(){
+        int refit = 0;
+        for(int i = 0; i < (int)_nodes.size(); i++){
+            //Only leaves have an object, static objects keep their revision and are skipped
+            SceneObject* object = _nodes[i].Object;
+            if(!object) continue;
+
+            unsigned int revision = revisionOf(object);
+            if(revision == _nodes[i].Revision) continue;
+
+            if(refitLeaf(i, revision)) refit++;
+        }
+
+        return refit;
+    }
+
+    void SceneBVH::insertLeaf(int leaf){
+        if(_root < 0){
+            _root = leaf;
+            _nodes[leaf].Parent = -1;
+            return;
+        }
+
+        //Descend towards the sibling with the lowest surface area cost
+        AABB leafBounds = _nodes[leaf].Bounds;
+        int index = _root;
+        while(!_nodes[index].IsLeaf()){
+            float area = _nodes[index].Bounds.GetSurfaceArea();
+            float combinedArea = AABB::Union(_nodes[index].Bounds, leafBounds).GetSurfaceArea();
+
+            float cost = 2.0f * combinedArea;
+            float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto childCost = [&](int child){
+                float unionArea = AABB::Union(_nodes[child].Bounds, leafBounds).GetSurfaceArea();
+                if(_nodes[child].IsLeaf()) return unionArea + inheritanceCost;
+                return unionArea - _nodes[child].Bounds.GetSurfaceArea() + inheritanceCost;
+            };
+
+            int left = _nodes[index].Left;
+            int right = _nodes[index].Right;
+            float costLeft = childCost(left);
+            float costRight = childCost(right);
+
+            if(cost < costLeft && cost < costRight) break;
+            index = costLeft < costRight ? left : right;
+        }
+
+        int sibling = index;
+        int oldParent = _nodes[sibling].Parent;
+        int newParent = allocateNode();
+        _nodes[newParent].Parent = oldParent;
+        _nodes[newParent].Bounds = AABB::Union(leafBounds, _nodes[sibling].Bounds);
+        _nodes[newParent].Left = sibling;
+        _nodes[newParent].Right = leaf;
+        _nodes[sibling].Parent = newParent;
+        _nodes[leaf].Parent = newParent;
+
+        if(oldParent >= 0){
+            if(_nodes[oldParent].Left == sibling) _nodes[oldParent].Left = newParent;
+            else _nodes[oldParent].Right = newParent;
+        } else {
+            _root = newParent;
+        }
+
+        refitFrom(newParent);
+    }
+
+    void SceneBVH::removeLeaf(int leaf){
+        if(leaf == _root){
+            _root = -1;
+            return;
+        }
+
+        int parent = _nodes[leaf].Parent;
+        int grandParent = _nodes[parent].Parent;
+        int sibling = _nodes[parent].Left == leaf ? _nodes[parent].Right : _nodes[parent].Left;
+
+        if(grandParent >= 0){
+            if(_nodes[grandParent].Left == parent) _nodes[grandParent].Left = sibling;
+            else _nodes[grandParent].Right = sibling;
+            _nodes[sibling].Parent = grandParent;
+            freeNode(parent);
+            refitFrom(grandParent);
+        } else {
+            _root = sibling;
+            _nodes[sibling].Parent = -1;
+            freeNode(parent);
+        }
+    }
+
+    void SceneBVH::refitFrom(int index){
+        while(index >= 0){
+            rotate(index);
+
+            Node& node = _nodes[index];
+            node.Bounds = AABB::Union(_nodes[node.Left].Bounds, _nodes[node.Right].Bounds);
+            index = node.Parent;
+        }
+    }
+
+    void SceneBVH::rotate(int index){
+        int b = _nodes[index].Left;
+        int c = _nodes[index].Right;
+
+        float bestGain = 0.0f;
+        int bestUpper = -1;
+        int bestLower = -1;
+
+        //Try swapping a child with one of its sibling's children, keeping the swap that shrinks the sibling most
+        auto tryRotation = [&](int upper, int other){
+            if(_nodes[other].IsLeaf()) return;
+
+            float otherArea = _nodes[other].Bounds.GetSurfaceArea();
+            int grandChildren[2] = { _nodes[other].Left, _nodes[other].Right };
+            for(int i = 0; i < 2; i++){
+                int lower = grandChildren[i];
+                int remaining = grandChildren[1 - i];
+                float gain = otherArea - AABB::Union(_nodes[upper].Bounds, _nodes[remaining].Bounds).GetSurfaceArea();
+                if(gain > bestGain){
+                    bestGain = gain;
+                    bestUpper = upper;
+                    bestLower = lower;
+                }
+            }
+        };
+
+        tryRotation(b, c);
+        tryRotation(c, b);
+
+        if(bestUpper >= 0) swapNodes(bestUpper, bestLower);
+    }
+
+    void SceneBVH::swapNodes(int upper, int lower){
+        int top = _nodes[upper].Parent;
+        int bottom = _nodes[lower].Parent;
+
+        if(_nodes[top].Left == upper) _nodes[top].Left = lower;
+        else _nodes[top].Right = lower;
+
+        if(_nodes[bottom].Left == lower) _nodes[bottom].Left = upper;
+        else _nodes[bottom].Right = upper;
+
+        _nodes[lower].Parent = top;
+        _nodes[upper].Parent = bottom;
+
+        _nodes[bottom].Bounds = AABB::Union(_nodes[_nodes[bottom].Left].Bounds, _nodes[_nodes[bottom].Right].Bounds);
+    }
+
+    void SceneBVH::QueryFrustum(const Frustum& frustum, std::vector<SceneObject*>& results){
+        auto test = [&](const AABB& bounds){ return frustum.IntersectsAABB(bounds); };
+        query(test, results);
+    }
+
+    void SceneBVH::QuerySphere(glm::vec3 center, float radius, std::vector<SceneObject*>& results){
+        auto test = [&](const AABB& bounds){ return bounds.IntersectsSphere(center, radius); };
+        query(test, results);
+    }
+
+    void SceneBVH::QueryAABB(const AABB& queryBounds, std::vector<SceneObject*>& results){
+        auto test = [&](const AABB& bounds){ return bounds.Intersects(queryBounds); };
+        query(test, results);
+    }
+
+    void SceneBVH::QueryRay(glm::vec3 origin, glm::vec3 direction, float maxDistance, std::vector<SceneObject*>& results){
+        glm::vec3 inverseDirection = 1.0f / glm::normalize(direction);
+        auto test = [&](const AABB& bounds){
+            float distance;
+            return bounds.IntersectsRay(origin, inverseDirection, maxDistance, distance);
+        };
+        query(test, results);
+    }
+
+    SceneObject* SceneBVH::Raycast(glm::vec3 origin, glm::vec3 direction, float maxDistance, float& distance){
+        glm::vec3 inverseDirection = 1.0f / glm::normalize(direction);
+
+        SceneObject* closest = nullptr;
+        float closestDistance = maxDistance;
+        auto test = [&](const AABB& bounds){
+            float hit;
+            return bounds.IntersectsRay(origin, inverseDirection, closestDistance, hit);
+        };
+
+        std::vector<SceneObject*> candidates;
+        query(test, candidates);
+
+        //Subtree hits only narrow the search, the closest object is picked by its own bounds
+
+        for(SceneObject* object : candidates){
+            float hit;
+            if(_ownBounds[object].IntersectsRay(origin, inverseDirection, closestDistance, hit) && hit <= closestDistance){
+                closest = object;
+                closestDistance = hit;
+            }
+        }
+
+        distance = closestDistance;
+        return closest;
+    }
+
+}
@@ -52,21 +52,28 @@ namespace GLEP {
     }
 
     glm::mat4 Camera::GetViewMatrix(){
-        updateViewMatrix();
+        ensureTransform();
+        if(_viewRevision != _transformRevision){
+            updateViewMatrix();
+            _viewRevision = _transformRevision;
+        }
         return _viewMatrix;
     }
 
     glm::vec3 Camera::GetFront() {
+        ensureTransform();
         updateVectors();
         return _front;
     }
 
     glm::vec3 Camera::GetRight() {
+        ensureTransform();
         updateVectors();
         return _right;
     }
 
     glm::vec3 Camera::GetUp() {
+        ensureTransform();
         updateVectors();
         return _up;
     }
@@ -0,0 +1,57 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <GLEP/core/component_store.hpp>
+
+namespace GLEP {
+
+    ComponentStore::ComponentStore(){}
+
+    size_t ComponentStore::GetCount(){
+        size_t count = 0;
+        for(std::unique_ptr<IComponentPool>& pool : _pools){
+            count += pool->GetCount();
+        }
+        return count;
+    }
+
+    void ComponentStore::Attach(SceneObject* object){
+        object->_componentStore = this;
+        for(std::shared_ptr<SceneObject>& child : object->GetChildren()){
+            Attach(child.get());
+        }
+    }
+
+    void ComponentStore::Detach(SceneObject* object){
+        for(std::unique_ptr<IComponentPool>& pool : _pools){
+            pool->Remove(object);
+        }
+        object->_componentStore = nullptr;
+
+        for(std::shared_ptr<SceneObject>& child : object->GetChildren()){
+            Detach(child.get());
+        }
+    }
+
+    void ComponentStore::Update(){
+        for(std::unique_ptr<IComponentPool>& pool : _pools){
+            pool->Update();
+        }
+    }
+
+}
@@ -23,11 +23,14 @@ namespace GLEP{
     CubeMap::CubeMap() {}
 
     CubeMap::~CubeMap() {
-        glDeleteTextures(1, &_ID);
+        DeferredGL::Cancel(this);
+
+        unsigned int ID = _ID;
+        DeferredGL::Run(nullptr, [ID](){ glDeleteTextures(1, &ID); });
     }
 
-    void CubeMap::Bind(){
-        glActiveTexture(GL_TEXTURE0 + 6);
+    void CubeMap::Bind(int unit){
+        glActiveTexture(GL_TEXTURE0 + unit);
         glBindTexture(GL_TEXTURE_CUBE_MAP, _ID);
     }
 
@@ -127,49 +130,57 @@ namespace GLEP{
     }
 
     void TextureCubeMap::initialize(){
-        glGenTextures(1, &_ID);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, _ID);
+        //Faces are decoded on this thread, the upload may be deferred to the GL context thread
+        std::vector<std::shared_ptr<unsigned char>> faces;
+        std::vector<glm::ivec3> sizes;
+        if(_filePaths.size() == 6){
+            for (unsigned int i = 0; i < _filePaths.size(); i++)
+            {
+                unsigned char *data = stbi_load(_filePaths[i].string().c_str(), &_width, &_height, &_nrChannels, 0);
+                if (!data)
+                    Print(PrintCode::ERROR, "CUBE_MAP", "Cube map texture failed to load at path: " + _filePaths[i].string());
 
-        if(_filePaths.size() != 6){
-            Print(PrintCode::ERROR, "CUBE_MAP", "Cube map does not contain exactly 6 textures.");
-            return;
+                faces.push_back(std::shared_ptr<unsigned char>(data, stbi_image_free));
+                sizes.push_back(glm::ivec3(_width, _height, _nrChannels));
+            }
         }
 
-        for (unsigned int i = 0; i < _filePaths.size(); i++)
-        {
-            unsigned char *data = stbi_load(_filePaths[i].string().c_str(), &_width, &_height, &_nrChannels, 0);
-            if (data)
+        DeferredGL::Run(this, [this, faces, sizes](){
+            glGenTextures(1, &_ID);
+            glBindTexture(GL_TEXTURE_CUBE_MAP, _ID);
+
+            if(_filePaths.size() != 6){
+                Print(PrintCode::ERROR, "CUBE_MAP", "Cube map does not contain exactly 6 textures.");
+                return;
+            }
+
+            for (unsigned int i = 0; i < faces.size(); i++)
             {
+                if (!faces[i]) continue;
+
                 GLenum format = GL_RGB;
-                if (_nrChannels == 1)
+                if (sizes[i].z == 1)
                     format = GL_RED;
-                else if (_nrChannels == 3)
+                else if (sizes[i].z == 3)
                     format = GL_RGB;
-                else if (_nrChannels == 4)
+                else if (sizes[i].z == 4)
                     format = GL_RGBA;
 
-                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, format, _width, _height, 0, format, GL_UNSIGNED_BYTE, data);
-
-                stbi_image_free(data);
+                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, format, sizes[i].x, sizes[i].y, 0, format, GL_UNSIGNED_BYTE, faces[i].get());
             }
-            else
-            {
-                Print(PrintCode::ERROR, "CUBE_MAP", "Cube map texture failed to load at path: " + _filePaths[i].string());
-                stbi_image_free(data);
-            }
-        }
 
-        #ifndef __APPLE__
-            glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-        #endif
+            #ifndef __APPLE__
+                glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+            #endif
 
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        });
         
-        if(_filePaths.size() > 0){
+        if(_filePaths.size() == 6){
             _thumbTex = std::make_shared<Texture>(_filePaths[0]);
         }
     }
@@ -231,6 +242,11 @@ namespace GLEP{
         initialize();
     }
 
+    BakedCubeMap::~BakedCubeMap(){
+        glDeleteFramebuffers(1, &_layeredFramebuffer);
+        glDeleteTextures(1, &_layeredDepthBuffer);
+    }
+
     void BakedCubeMap::initialize(){
         glGenTextures(1, &_ID);
         glBindTexture(GL_TEXTURE_CUBE_MAP, _ID);
@@ -261,6 +277,51 @@ namespace GLEP{
         glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, _ID, 0, index);
     }
 
+    void BakedCubeMap::initializeLayered(){
+        glGenTextures(1, &_layeredDepthBuffer);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, _layeredDepthBuffer);
+
+        for (int i = 0; i < 6; ++i) {
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_DEPTH_COMPONENT, _width, _height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+        }
+
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+        glGenFramebuffers(1, &_layeredFramebuffer);
+    }
+
+    bool BakedCubeMap::BindLayeredBuffer(int index){
+        if(index < -1 || index > 5) return false;
+        if(!_layeredFramebuffer) initializeLayered();
+
+        glBindFramebuffer(GL_FRAMEBUFFER, _layeredFramebuffer);
+
+        if(index == -1){
+            glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, _ID, 0);
+            glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, _layeredDepthBuffer, 0);
+        } else {
+            glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, _ID, 0, index);
+            glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, _layeredDepthBuffer, 0, index);
+        }
+        glDrawBuffer(GL_COLOR_ATTACHMENT0);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE){
+            Print(PrintCode::ERROR, "CUBE_MAP", "Layered framebuffer is not complete.");
+            return false;
+        }
+
+        return true;
+    }
+
+    glm::mat4 BakedCubeMap::GetFaceViewProjection(int index){
+        SetDirection(index);
+        return _camera->GetProjectionMatrix() * _camera->GetViewMatrix();
+    }
+
     void BakedCubeMap::UnbindBuffer(){
         _framebuffer->Unbind();
 
@@ -272,6 +333,22 @@ namespace GLEP{
         _camera->Position = position;
     }
 
+    int BakedCubeMap::GetPendingFaces(){ return _pendingFaces; }
+    bool BakedCubeMap::GetIsBaked(){ return _lastUpdateTime >= 0.0f; }
+    float BakedCubeMap::GetLastUpdateTime(){ return _lastUpdateTime; }
+
+    void BakedCubeMap::RequestUpdate(){
+        _pendingFaces = ALL_FACES;
+    }
+
+    void BakedCubeMap::MarkFaceUpdated(int index){
+        if(index < 0 || index > 5) return;
+
+        _pendingFaces &= ~(1 << index);
+        if(!_pendingFaces)
+            _lastUpdateTime = Time::GetElapsedTimeF();
+    }
+
     glm::vec3 BakedCubeMap::GetPosition(){ return _camera->Position; }
     std::shared_ptr<Camera> BakedCubeMap::GetCamera(){ return _camera; }
     std::shared_ptr<Framebuffer> BakedCubeMap::GetFramebuffer(){ return _framebuffer; }
@@ -281,13 +358,22 @@ namespace GLEP{
         j["type"] = "baked_cube_map";
         j["position"] = Math::ToJson(GetPosition());
         j["buffer_size"] = GetFramebuffer()->GetWidth();
+        j["update_mode"] = UpdateMode;
+        j["influence_radius"] = InfluenceRadius;
         return j;
     }
 
     std::shared_ptr<BakedCubeMap> BakedCubeMap::FromJson(const json& data){
-        return std::make_shared<BakedCubeMap>(
+        std::shared_ptr<BakedCubeMap> result = std::make_shared<BakedCubeMap>(
             Math::Vec3FromJson(data["position"]),
             data["buffer_size"]
         );
+
+        if(data.contains("update_mode"))
+            result->UpdateMode = (ProbeUpdateMode) data["update_mode"];
+        if(data.contains("influence_radius"))
+            result->InfluenceRadius = data["influence_radius"];
+
+        return result;
     }
 }
\ No newline at end of file
@@ -0,0 +1,382 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <GLEP/core/frame_capture.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "stb/stb_image_write.h"
+
+namespace GLEP {
+
+    static const char* extension(CaptureFormat format){
+        switch(format){
+            case CaptureFormat::JPG: return ".jpg";
+            case CaptureFormat::RAW: return ".rgba";
+            default: return ".png";
+        }
+    }
+
+    //Full range BT.601 in 8-bit fixed point, chroma is averaged over each 2x2 block
+    static void toYUV420(const unsigned char* rgba, int width, int height, std::vector<unsigned char>& planes){
+        int chromaWidth = (width + 1) / 2;
+        int chromaHeight = (height + 1) / 2;
+        planes.resize((size_t)width * height + 2 * (size_t)chromaWidth * chromaHeight);
+
+        unsigned char* y = planes.data();
+        unsigned char* u = y + (size_t)width * height;
+        unsigned char* v = u + (size_t)chromaWidth * chromaHeight;
+
+        for(int i = 0; i < width * height; i++){
+            const unsigned char* p = rgba + (size_t)i * 4;
+            y[i] = (unsigned char)((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+        }
+
+        for(int cy = 0; cy < chromaHeight; cy++){
+            int y0 = cy * 2;
+            int y1 = std::min(y0 + 1, height - 1);
+
+            for(int cx = 0; cx < chromaWidth; cx++){
+                int x0 = cx * 2;
+                int x1 = std::min(x0 + 1, width - 1);
+
+                const unsigned char* p[4] = {
+                    rgba + ((size_t)y0 * width + x0) * 4, rgba + ((size_t)y0 * width + x1) * 4,
+                    rgba + ((size_t)y1 * width + x0) * 4, rgba + ((size_t)y1 * width + x1) * 4
+                };
+
+                int r = (p[0][0] + p[1][0] + p[2][0] + p[3][0] + 2) >> 2;
+                int g = (p[0][1] + p[1][1] + p[2][1] + p[3][1] + 2) >> 2;
+                int b = (p[0][2] + p[1][2] + p[2][2] + p[3][2] + 2) >> 2;
+
+                size_t index = (size_t)cy * chromaWidth + cx;
+                u[index] = (unsigned char)std::min((-43 * r - 85 * g + 128 * b + 32896) >> 8, 255);
+                v[index] = (unsigned char)std::min((128 * r - 107 * g - 21 * b + 32896) >> 8, 255);
+            }
+        }
+    }
+
+    FrameCapture::FrameCapture(std::filesystem::path path, CaptureFormat format, int latency, int queuedFrames, unsigned int threads){
+        _path = path;
+        _format = format;
+
+        _slots.resize(std::max(latency, 1));
+        for(ReadbackSlot& slot : _slots){
+            glGenBuffers(1, &slot.Buffer);
+        }
+
+        _jobs.resize(std::max(queuedFrames, 1));
+
+        if(_format == CaptureFormat::Y4M){
+            if(_path.has_parent_path()) std::filesystem::create_directories(_path.parent_path());
+            _stream.open(_path, std::ios::binary);
+            if(!_stream) Print(PrintCode::ERROR, "FRAME_CAPTURE", "Failed to open capture stream at " + _path.string());
+        } else {
+            std::filesystem::create_directories(_path);
+        }
+
+        //Leave a core for the render thread, hardware_concurrency may report 0 so clamp before subtracting
+        unsigned int threadCount = threads ? threads : std::max(2u, std::thread::hardware_concurrency()) - 1;
+        for(unsigned int i = 0; i < threadCount; i++){
+            _workers.emplace_back(&FrameCapture::workerLoop, this);
+        }
+    }
+
+    FrameCapture::~FrameCapture(){
+        Flush();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _condition.notify_all();
+
+        for(std::thread& worker : _workers){
+            worker.join();
+        }
+
+        for(ReadbackSlot& slot : _slots){
+            if(slot.Fence) glDeleteSync(slot.Fence);
+            glDeleteBuffers(1, &slot.Buffer);
+        }
+    }
+
+    const std::filesystem::path& FrameCapture::GetPath(){ return _path; }
+    CaptureFormat FrameCapture::GetFormat(){ return _format; }
+
+    FrameCaptureStats FrameCapture::GetStats(){
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        FrameCaptureStats stats = _stats;
+        stats.InFlight = _inFlight;
+        for(const EncodeJob& job : _jobs){
+            if(job.State != JobState::FREE) stats.Queued++;
+        }
+
+        return stats;
+    }
+
+    void FrameCapture::workerLoop(){
+        while(true){
+            EncodeJob* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this](){
+                    if(_stopping) return true;
+                    for(const EncodeJob& j : _jobs){
+                        if(j.State == JobState::QUEUED) return true;
+                    }
+                    return false;
+                });
+
+                //Oldest first, so a stream writer never waits on a frame no thread has picked up
+                for(EncodeJob& j : _jobs){
+                    if(j.State == JobState::QUEUED && (!job || j.Sequence < job->Sequence)) job = &j;
+                }
+                if(!job) return;
+
+                job->State = JobState::ENCODING;
+            }
+
+            encode(*job);
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                job->State = JobState::FREE;
+            }
+            _condition.notify_all();
+        }
+    }
+
+    void FrameCapture::encode(EncodeJob& job){
+        bool success = _format == CaptureFormat::Y4M ? writeStream(job) : writeImage(job);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(success) _stats.Encoded++;
+        else _stats.Failed++;
+    }
+
+    bool FrameCapture::writeImage(EncodeJob& job){
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%06u%s", job.Sequence, extension(_format));
+        std::filesystem::path path = _path / name;
+
+        bool success;
+        switch(_format){
+            case CaptureFormat::JPG:
+                success = stbi_write_jpg(path.string().c_str(), job.Width, job.Height, 4, job.Pixels.data(), Quality) != 0;
+                break;
+
+            case CaptureFormat::RAW: {
+                std::ofstream f(path, std::ios::binary);
+                f.write(reinterpret_cast<const char*>(job.Pixels.data()), (std::streamsize)job.Pixels.size());
+                success = f.good();
+                break;
+            }
+
+            default:
+                success = stbi_write_png(path.string().c_str(), job.Width, job.Height, 4, job.Pixels.data(), job.Width * 4) != 0;
+                break;
+        }
+
+        if(!success) Print(PrintCode::ERROR, "FRAME_CAPTURE", "Failed to write frame to " + path.string());
+        return success;
+    }
+
+    bool FrameCapture::writeStream(EncodeJob& job){
+        toYUV420(job.Pixels.data(), job.Width, job.Height, job.Planes);
+
+        std::unique_lock<std::mutex> lock(_streamMutex);
+        _streamCondition.wait(lock, [&](){ return _nextWrite == job.Sequence; });
+
+        bool success = (bool)_stream;
+        if(success && _nextWrite == 0){
+            _streamResolution = glm::ivec2(job.Width, job.Height);
+            _stream << "YUV4MPEG2 W" << job.Width << " H" << job.Height << " F" << FrameRate << ":1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n";
+        }
+
+        //A stream can't change size, frames rendered at another resolution are skipped
+        if(success && _streamResolution != glm::ivec2(job.Width, job.Height)){
+            Print(PrintCode::ERROR, "FRAME_CAPTURE", "Frame " + std::to_string(job.Sequence) + " doesn't match the capture stream resolution, skipping");
+            success = false;
+        }
+
+        if(success){
+            _stream << "FRAME\n";
+            _stream.write(reinterpret_cast<const char*>(job.Planes.data()), (std::streamsize)job.Planes.size());
+            success = _stream.good();
+        }
+
+        _nextWrite++;
+        lock.unlock();
+        _streamCondition.notify_all();
+
+        return success;
+    }
+
+    bool FrameCapture::retire(bool wait){
+        if(_inFlight == 0) return false;
+
+        ReadbackSlot& slot = _slots[_head];
+
+        GLenum status = glClientWaitSync(slot.Fence, 0, 0);
+        while(wait && status == GL_TIMEOUT_EXPIRED){
+            status = glClientWaitSync(slot.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        }
+        if(status == GL_TIMEOUT_EXPIRED) return false;
+
+        EncodeJob* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            auto findFree = [&](){
+                for(EncodeJob& j : _jobs){
+                    if(j.State == JobState::FREE){
+                        job = &j;
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            //A full encode queue leaves the frame in its buffer, which fills the ring and pushes back on Capture
+            if(!findFree()){
+                if(!wait) return false;
+                _condition.wait(lock, findFree);
+            }
+
+            job->State = JobState::READING;
+        }
+
+        size_t rowSize = (size_t)slot.Width * 4;
+        size_t size = rowSize * slot.Height;
+        job->Pixels.resize(size);
+        job->Width = slot.Width;
+        job->Height = slot.Height;
+        job->Sequence = slot.Sequence;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+        const unsigned char* pixels = static_cast<const unsigned char*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT));
+
+        //Rows are read bottom up, flip them while copying out
+        if(pixels){
+            for(int row = 0; row < slot.Height; row++){
+                std::memcpy(job->Pixels.data() + rowSize * row, pixels + rowSize * (slot.Height - 1 - row), rowSize);
+            }
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        } else {
+            Print(PrintCode::ERROR, "FRAME_CAPTURE", "Failed to map readback of frame " + std::to_string(slot.Sequence));
+            std::fill(job->Pixels.begin(), job->Pixels.end(), 0);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        glDeleteSync(slot.Fence);
+        slot.Fence = nullptr;
+
+        _head = (_head + 1) % (int)_slots.size();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            job->State = JobState::QUEUED;
+            _inFlight--;
+        }
+        _condition.notify_one();
+
+        return true;
+    }
+
+    bool FrameCapture::capture(unsigned int framebuffer, int width, int height){
+        Update();
+
+        if(width <= 0 || height <= 0) return false;
+
+        if(_inFlight == (int)_slots.size() && (Overflow == CaptureOverflow::DROP || !retire(true))){
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stats.Dropped++;
+            return false;
+        }
+
+        ReadbackSlot& slot = _slots[(_head + _inFlight) % (int)_slots.size()];
+        size_t size = (size_t)width * height * 4;
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+        glReadBuffer(framebuffer ? GL_COLOR_ATTACHMENT0 : GL_BACK);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+        if(slot.Capacity < size){
+            glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+            slot.Capacity = size;
+        }
+
+        //Copies into the pack buffer asynchronously, the fence marks when it can be mapped without stalling
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        slot.Width = width;
+        slot.Height = height;
+        slot.Sequence = _sequence++;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _inFlight++;
+        _stats.Captured++;
+
+        return true;
+    }
+
+    bool FrameCapture::Capture(const std::shared_ptr<Framebuffer>& framebuffer){
+        if(!framebuffer || framebuffer->GetIsDepthOnly()){
+            Print(PrintCode::ERROR, "FRAME_CAPTURE", "Attempted to capture a framebuffer without a color buffer.");
+            return false;
+        }
+
+        framebuffer->Resolve();
+        return capture(framebuffer->GetResolvedBufferID(), framebuffer->GetWidth(), framebuffer->GetHeight());
+    }
+
+    bool FrameCapture::Capture(const std::shared_ptr<Window>& window){
+        if(!window) return false;
+
+        glm::vec2 resolution = window->GetResolution();
+        return capture(0, (int)resolution.x, (int)resolution.y);
+    }
+
+    void FrameCapture::Update(){
+        while(retire(false));
+    }
+
+    void FrameCapture::Flush(){
+        while(retire(true));
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this](){
+            for(const EncodeJob& job : _jobs){
+                if(job.State != JobState::FREE) return false;
+            }
+            return true;
+        });
+        lock.unlock();
+
+        std::lock_guard<std::mutex> streamLock(_streamMutex);
+        _stream.flush();
+    }
+
+}
@@ -18,6 +18,47 @@
 #include <GLEP/core/framebuffer.hpp>
 
 namespace GLEP {
+
+    struct ColorFormat{
+        GLenum Internal;
+        GLenum Format;
+        GLenum Type;
+        int Bytes;
+    };
+
+    static ColorFormat colorFormat(FramebufferColor color){
+        switch(color){
+            case FramebufferColor::RGBA8: return {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4};
+            case FramebufferColor::RGB10A2: return {GL_RGB10_A2, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV, 4};
+            case FramebufferColor::R11G11B10F: return {GL_R11F_G11F_B10F, GL_RGB, GL_UNSIGNED_INT_10F_11F_11F_REV, 4};
+            case FramebufferColor::RGBA16F: return {GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8};
+            //RGB8 is padded to four bytes by most drivers
+            default: return {GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, 4};
+        }
+    }
+
+    //Sized so multisampled depth can be blitted into the resolve texture
+    static const GLenum DEPTH_FORMAT = GL_DEPTH_COMPONENT24;
+    static const int DEPTH_BYTES = 4;
+
+    static unsigned int createTexture(GLenum filter){
+        unsigned int texture;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        return texture;
+    }
+
+    static unsigned int createRenderbuffer(){
+        unsigned int renderbuffer;
+        glGenRenderbuffers(1, &renderbuffer);
+        return renderbuffer;
+    }
     
     Framebuffer::Framebuffer(){}
 
@@ -28,68 +69,193 @@ namespace GLEP {
         initialize();
     }
 
+    Framebuffer::Framebuffer(glm::vec2 resolution, const FramebufferDesc& desc){
+        _width = (int)resolution.x;
+        _height = (int)resolution.y;
+        _desc = desc;
+
+        initialize();
+    }
+
     Framebuffer::~Framebuffer(){
+        release();
+    }
+
+    void Framebuffer::release(){
         glDeleteFramebuffers(1, &_framebuffer);
+        glDeleteFramebuffers(1, &_resolveFramebuffer);
         glDeleteTextures(1, &_colorBuffer);
         glDeleteTextures(1, &_depthBuffer);
+        glDeleteRenderbuffers(1, &_colorRenderbuffer);
+        glDeleteRenderbuffers(1, &_depthRenderbuffer);
+
+        _framebuffer = 0;
+        _resolveFramebuffer = 0;
+        _colorBuffer = 0;
+        _depthBuffer = 0;
+        _colorRenderbuffer = 0;
+        _depthRenderbuffer = 0;
     }
 
     void Framebuffer::initialize(){
+        release();
+
+        _samples = _desc.Samples;
+        if(_samples > 1){
+            GLint maxSamples = 0;
+            glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+            _samples = glm::min(_samples, (int)maxSamples);
+        }
+
+        bool multisampled = GetIsMultisampled();
+        bool hasColor = _desc.Color != FramebufferColor::NONE;
+
+        if(hasColor){
+            _colorBuffer = createTexture(GL_LINEAR);
+            if(multisampled) _colorRenderbuffer = createRenderbuffer();
+        }
+
+        if(_desc.Depth == FramebufferDepth::TEXTURE)
+            _depthBuffer = createTexture(GL_NEAREST);
+
+        //Depth that is never sampled stays in a renderbuffer, which drivers can keep compressed or on-chip
+        if(_desc.Depth == FramebufferDepth::RENDERBUFFER || (_desc.Depth == FramebufferDepth::TEXTURE && multisampled))
+            _depthRenderbuffer = createRenderbuffer();
+
+        allocateStorage();
+
         glGenFramebuffers(1, &_framebuffer);
         glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
-        
-        glGenTextures(1, &_colorBuffer);
-        glBindTexture(GL_TEXTURE_2D, _colorBuffer);
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, _width, _height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _colorBuffer, 0);
-                
-        glGenTextures(1, &_depthBuffer);
-        glBindTexture(GL_TEXTURE_2D, _depthBuffer);
+        //Sampleable textures live on the resolve framebuffer when multisampled, otherwise they are drawn to directly
+        if(_colorRenderbuffer) glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, _colorRenderbuffer);
+        else if(_colorBuffer) glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _colorBuffer, 0);
+        else{
+            glDrawBuffer(GL_NONE);
+            glReadBuffer(GL_NONE);
+        }
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, _width, _height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, _depthBuffer, 0);
+        if(_depthRenderbuffer) glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, _depthRenderbuffer);
+        else if(_depthBuffer) glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, _depthBuffer, 0);
     
         if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
             Print(PrintCode::ERROR, "FRAMEBUFFER", "Framebuffer is not complete.");
 
+        if(multisampled && (_colorBuffer || _depthBuffer)){
+            glGenFramebuffers(1, &_resolveFramebuffer);
+            glBindFramebuffer(GL_FRAMEBUFFER, _resolveFramebuffer);
+
+            if(_colorBuffer) glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _colorBuffer, 0);
+            else{
+                glDrawBuffer(GL_NONE);
+                glReadBuffer(GL_NONE);
+            }
+
+            if(_depthBuffer) glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, _depthBuffer, 0);
+
+            if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+                Print(PrintCode::ERROR, "FRAMEBUFFER", "Resolve framebuffer is not complete.");
+        }
+
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
 
+    void Framebuffer::allocateStorage(){
+        ColorFormat color = colorFormat(_desc.Color);
+
+        if(_colorBuffer){
+            glBindTexture(GL_TEXTURE_2D, _colorBuffer);
+            glTexImage2D(GL_TEXTURE_2D, 0, color.Internal, _width, _height, 0, color.Format, color.Type, NULL);
+        }
+
+        if(_depthBuffer){
+            glBindTexture(GL_TEXTURE_2D, _depthBuffer);
+            glTexImage2D(GL_TEXTURE_2D, 0, DEPTH_FORMAT, _width, _height, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
+        }
+
+        auto renderbufferStorage = [this](unsigned int renderbuffer, GLenum internalFormat){
+            glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+            if(_samples > 1) glRenderbufferStorageMultisample(GL_RENDERBUFFER, _samples, internalFormat, _width, _height);
+            else glRenderbufferStorage(GL_RENDERBUFFER, internalFormat, _width, _height);
+        };
+
+        if(_colorRenderbuffer) renderbufferStorage(_colorRenderbuffer, color.Internal);
+        if(_depthRenderbuffer) renderbufferStorage(_depthRenderbuffer, DEPTH_FORMAT);
+    }
+
     unsigned int Framebuffer::GetBufferID(){ return _framebuffer; }
+    unsigned int Framebuffer::GetResolvedBufferID(){ return _resolveFramebuffer ? _resolveFramebuffer : _framebuffer; }
     unsigned int Framebuffer::GetColorBufferID(){ return _colorBuffer; }
     unsigned int Framebuffer::GetDepthBufferID(){ return _depthBuffer; }
     int Framebuffer::GetWidth(){ return _width; }
     int Framebuffer::GetHeight(){ return _height; }
+    const FramebufferDesc& Framebuffer::GetDesc(){ return _desc; }
+    bool Framebuffer::GetIsDepthOnly(){ return _desc.Color == FramebufferColor::NONE; }
+    bool Framebuffer::GetIsMultisampled(){ return _samples > 1; }
+
+    size_t Framebuffer::GetAllocatedBytes(){
+        size_t pixels = (size_t)_width * _height;
+        size_t samples = (size_t)glm::max(_samples, 1);
+        size_t bytes = 0;
+
+        if(_desc.Color != FramebufferColor::NONE){
+            size_t color = pixels * colorFormat(_desc.Color).Bytes;
+            bytes += GetIsMultisampled() ? color * (samples + 1) : color;
+        }
+
+        if(_desc.Depth != FramebufferDepth::NONE){
+            size_t depth = pixels * DEPTH_BYTES;
+            bytes += depth * samples;
+            if(_desc.Depth == FramebufferDepth::TEXTURE && GetIsMultisampled()) bytes += depth;
+        }
+
+        return bytes;
+    }
 
     void Framebuffer::SetDepthBufferID(unsigned int depthBuffer){
         _depthBuffer = depthBuffer;
     }
 
     void Framebuffer::SetResolution(glm::vec2 resolution){
-        _width = (int)resolution.x;
-        _height = (int)resolution.y;
+        int width = (int)resolution.x;
+        int height = (int)resolution.y;
+        if(_framebuffer && width == _width && height == _height) return;
 
-        initialize();
+        _width = width;
+        _height = height;
+
+        if(!_framebuffer){
+            initialize();
+            return;
+        }
+
+        //Storage is respecified on the existing objects, so attachments, names and bound uniforms stay valid
+        allocateStorage();
     }
 
     void Framebuffer::Bind(){
         glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
-
-        GLuint attachments[2] = { GL_COLOR_ATTACHMENT0, GL_DEPTH_ATTACHMENT };
-        glDrawBuffers(2, attachments);
+        glDrawBuffer(GetIsDepthOnly() ? GL_NONE : GL_COLOR_ATTACHMENT0);
     }
 
     void Framebuffer::Unbind(){
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
 
+    void Framebuffer::Resolve(){
+        if(!_resolveFramebuffer) return;
+
+        GLbitfield mask = 0;
+        if(_colorBuffer) mask |= GL_COLOR_BUFFER_BIT;
+        if(_depthBuffer) mask |= GL_DEPTH_BUFFER_BIT;
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _resolveFramebuffer);
+        glBlitFramebuffer(0, 0, _width, _height, 0, 0, _width, _height, mask, GL_NEAREST);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    }
+
     void Framebuffer::BindResult(){
         glActiveTexture(GL_TEXTURE0 + 4);
         glBindTexture(GL_TEXTURE_2D, _colorBuffer);
@@ -98,4 +264,4 @@ namespace GLEP {
         glBindTexture(GL_TEXTURE_2D, _depthBuffer);
     }
         
-}
\ No newline at end of file
+}
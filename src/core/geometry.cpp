@@ -19,6 +19,9 @@
 
 namespace GLEP {
 
+    thread_local const std::vector<GeometryBlob>* Geometry::_blobSource = nullptr;
+    std::atomic<unsigned int> Geometry::_nextBoundsRevision{0};
+
     Geometry::Geometry(){}
 
     Geometry::Geometry(std::vector<Vertex> vertices, std::vector<unsigned int> indices){
@@ -28,43 +31,99 @@ namespace GLEP {
         initialize();
     }
 
+    Geometry::Geometry(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount){
+        _vertices.assign(vertices, vertices + vertexCount);
+        _indices.assign(indices, indices + indexCount);
+
+        initialize();
+    }
+
+    void Geometry::SetBlobSource(const std::vector<GeometryBlob>* blobs){
+        _blobSource = blobs;
+    }
+
+    const std::vector<GeometryBlob>* Geometry::GetBlobSource(){
+        return _blobSource;
+    }
+
+    GeometryBlobScope::GeometryBlobScope(const std::vector<GeometryBlob>* blobs){
+        _previous = Geometry::GetBlobSource();
+        Geometry::SetBlobSource(blobs);
+    }
+
+    GeometryBlobScope::~GeometryBlobScope(){
+        Geometry::SetBlobSource(_previous);
+    }
+
     Geometry::~Geometry(){
-        glDeleteVertexArrays(1, &_VAO);
-        glDeleteBuffers(1, &_VBO);
-        glDeleteBuffers(1, &_EBO);
+        DeferredGL::Cancel(this);
+
+        unsigned int VAO = _VAO, VBO = _VBO, EBO = _EBO;
+        DeferredGL::Run(nullptr, [VAO, VBO, EBO](){
+            glDeleteVertexArrays(1, &VAO);
+            glDeleteBuffers(1, &VBO);
+            glDeleteBuffers(1, &EBO);
+        });
     }
 
     void Geometry::initialize(){
-        glGenVertexArrays(1, &_VAO);
-        glGenBuffers(1, &_VBO);
-        glGenBuffers(1, &_EBO);
+        updateBounds();
 
-        glBindVertexArray(_VAO);
+        DeferredGL::Run(this, [this](){
+            glGenVertexArrays(1, &_VAO);
+            glGenBuffers(1, &_VBO);
+            glGenBuffers(1, &_EBO);
 
-        glBindBuffer(GL_ARRAY_BUFFER, _VBO);
-        glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(Vertex), &_vertices[0], GL_STATIC_DRAW);
+            glBindVertexArray(_VAO);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indices.size() * sizeof(unsigned int), &_indices[0], GL_STATIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, _VBO);
+            glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(Vertex), &_vertices[0], GL_STATIC_DRAW);
 
-        //WorldPosition
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-        //Normal
-        glEnableVertexAttribArray(1);	
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
-        //TexCoords
-        glEnableVertexAttribArray(2);	
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoord));
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _EBO);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indices.size() * sizeof(unsigned int), &_indices[0], GL_STATIC_DRAW);
 
-        _hasInit = true;
+            //WorldPosition
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+            //Normal
+            glEnableVertexAttribArray(1);	
+            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+            //TexCoords
+            glEnableVertexAttribArray(2);	
+            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoord));
+
+            _hasInit = true;
 
-        glBindBuffer(GL_ARRAY_BUFFER, 0); 
-        glBindVertexArray(0); 
+            glBindBuffer(GL_ARRAY_BUFFER, 0); 
+            glBindVertexArray(0); 
+        });
     }
 
     std::vector<Vertex> Geometry::GetVertices() { return _vertices; }
     std::vector<unsigned int> Geometry::GetIndices() { return _indices; }
+    size_t Geometry::GetVertexCount() { return _vertices.size(); }
+    size_t Geometry::GetIndexCount() { return _indices.size(); }
+    glm::vec3 Geometry::GetBoundsMin() { return _boundsMin; }
+    glm::vec3 Geometry::GetBoundsMax() { return _boundsMax; }
+    unsigned int Geometry::GetBoundsRevision() { return _boundsRevision; }
+
+    void Geometry::updateBounds(){
+        //Drawn from a shared counter so swapping in another geometry also changes the revision
+        _boundsRevision = ++_nextBoundsRevision;
+
+        if(_vertices.empty()){
+            _boundsMin = glm::vec3(0.0f);
+            _boundsMax = glm::vec3(0.0f);
+            return;
+        }
+
+        _boundsMin = _vertices[0].Position;
+        _boundsMax = _vertices[0].Position;
+        for(const Vertex& v : _vertices){
+            _boundsMin = glm::min(_boundsMin, v.Position);
+            _boundsMax = glm::max(_boundsMax, v.Position);
+        }
+    }
 
     void Geometry::SetVertices(std::vector<Vertex> vertices){
         _vertices = vertices;
@@ -77,27 +136,33 @@ namespace GLEP {
     }
 
     void Geometry::bindVertices(){
-        glBindVertexArray(_VAO);
+        updateBounds();
 
-        glBindBuffer(GL_ARRAY_BUFFER, _VBO);
-        glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(Vertex), &_vertices[0], GL_STATIC_DRAW);
+        DeferredGL::Run(this, [this](){
+            glBindVertexArray(_VAO);
 
-        //WorldPosition
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-        //Normal
-        glEnableVertexAttribArray(1);	
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
-        //TexCoords
-        glEnableVertexAttribArray(2);	
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoord));
+            glBindBuffer(GL_ARRAY_BUFFER, _VBO);
+            glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(Vertex), &_vertices[0], GL_STATIC_DRAW);
+
+            //WorldPosition
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+            //Normal
+            glEnableVertexAttribArray(1);	
+            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+            //TexCoords
+            glEnableVertexAttribArray(2);	
+            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoord));
+        });
     }
 
     void Geometry::bindIndices(){
-        glBindVertexArray(_VAO);
+        DeferredGL::Run(this, [this](){
+            glBindVertexArray(_VAO);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indices.size() * sizeof(unsigned int), &_indices[0], GL_STATIC_DRAW);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _EBO);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indices.size() * sizeof(unsigned int), &_indices[0], GL_STATIC_DRAW);
+        });
     }
 
     void Geometry::Draw(){
@@ -132,10 +197,12 @@ namespace GLEP {
             }
         }
 
-        glBindVertexArray(_VAO);
+        DeferredGL::Run(this, [this](){
+            glBindVertexArray(_VAO);
 
-        glBindBuffer(GL_ARRAY_BUFFER, _VBO);
-        glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(Vertex), &_vertices[0], GL_STATIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, _VBO);
+            glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(Vertex), &_vertices[0], GL_STATIC_DRAW);
+        });
     }
 
     json Geometry::ToJson(){
@@ -158,7 +225,16 @@ namespace GLEP {
     std::shared_ptr<Geometry> Geometry::FromJson(const json& data){
         std::shared_ptr<Geometry> result;
 
-        if(data["type"] == "geometry"){
+        if(data["type"] == "geometry" && data.contains("blob")){
+            size_t index = data["blob"];
+            if(!_blobSource || index >= _blobSource->size()){
+                Print(PrintCode::ERROR, "GEOMETRY", "Geometry blob " + std::to_string(index) + " is not available, blobs can only be loaded from a binary scene.");
+                return nullptr;
+            }
+
+            const GeometryBlob& blob = (*_blobSource)[index];
+            result = std::make_shared<Geometry>(blob.Vertices, blob.VertexCount, blob.Indices, blob.IndexCount);
+        } else if(data["type"] == "geometry"){
             std::vector<Vertex> vertices;
             for(int i = 0; i < data["vertices"].size(); i++){
                 vertices.push_back(Vertex::FromJson(data["vertices"][i]));
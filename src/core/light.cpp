@@ -19,6 +19,22 @@
 
 namespace GLEP {
 
+    //Names are built once per light index, binding lights for every draw would otherwise allocate each string
+    template <size_t N>
+    static const std::string* lightUniformNames(std::vector<std::vector<std::string>>& cache, const char* array, const char* const (&members)[N], int index){
+        while(cache.size() <= index){
+            std::string prefix = std::string(array) + "[" + std::to_string(cache.size()) + "].";
+
+            std::vector<std::string> names;
+            for(const char* member : members){
+                names.push_back(prefix + member);
+            }
+            cache.push_back(names);
+        }
+
+        return cache[index].data();
+    }
+
     Light::Light(LightType type, Color lightColor, float intensity){
         _type = type;
 
@@ -62,8 +78,11 @@ namespace GLEP {
     : Light(LightType::AMBIENT, lightColor, intensity){}
 
     void AmbientLight::Bind(const std::shared_ptr<Material>& material, int index){
-        material->SetUniform("uAmbient.color", LightColor);
-        material->SetUniform("uAmbient.intensity", Intensity);
+        static const std::string colorName = "uAmbient.color";
+        static const std::string intensityName = "uAmbient.intensity";
+
+        material->SetUniform(colorName, LightColor);
+        material->SetUniform(intensityName, Intensity);
     }
 
     json AmbientLight::ToJson(){
@@ -92,12 +111,16 @@ namespace GLEP {
     }
 
     void PointLight::Bind(const std::shared_ptr<Material>& material, int index){
-        material->SetUniform("uPointLights[" + std::to_string(index) + "].position", Position);
-        material->SetUniform("uPointLights[" + std::to_string(index) + "].color", LightColor);
-        material->SetUniform("uPointLights[" + std::to_string(index) + "].intensity", Intensity);
-        material->SetUniform("uPointLights[" + std::to_string(index) + "].constant", Constant);
-        material->SetUniform("uPointLights[" + std::to_string(index) + "].linear", Linear);
-        material->SetUniform("uPointLights[" + std::to_string(index) + "].quadratic", Quadratic);
+        static const char* const members[] = {"position", "color", "intensity", "constant", "linear", "quadratic"};
+        static std::vector<std::vector<std::string>> nameCache;
+        const std::string* names = lightUniformNames(nameCache, "uPointLights", members, index);
+
+        material->SetUniform(names[0], Position);
+        material->SetUniform(names[1], LightColor);
+        material->SetUniform(names[2], Intensity);
+        material->SetUniform(names[3], Constant);
+        material->SetUniform(names[4], Linear);
+        material->SetUniform(names[5], Quadratic);
     }
 
     json PointLight::ToJson(){
@@ -131,9 +154,13 @@ namespace GLEP {
     }
 
     void DirectionalLight::Bind(const std::shared_ptr<Material>& material, int index){
-        material->SetUniform("uDirectionalLight.direction", Direction);
-        material->SetUniform("uDirectionalLight.color", LightColor);
-        material->SetUniform("uDirectionalLight.intensity", Intensity);
+        static const std::string directionName = "uDirectionalLight.direction";
+        static const std::string colorName = "uDirectionalLight.color";
+        static const std::string intensityName = "uDirectionalLight.intensity";
+
+        material->SetUniform(directionName, Direction);
+        material->SetUniform(colorName, LightColor);
+        material->SetUniform(intensityName, Intensity);
     }
 
     json DirectionalLight::ToJson(){
@@ -167,15 +194,19 @@ namespace GLEP {
     }
 
     void SpotLight::Bind(const std::shared_ptr<Material>& material, int index){
-        material->SetUniform("uSpotLights[" + std::to_string(index) + "].position", Position);
-        material->SetUniform("uSpotLights[" + std::to_string(index) + "].direction", Direction);
-        material->SetUniform("uSpotLights[" + std::to_string(index) + "].color", LightColor);
-        material->SetUniform("uSpotLights[" + std::to_string(index) + "].intensity", Intensity);
-        material->SetUniform("uSpotLights[" + std::to_string(index) + "].innerCutOff", InnerCutOff);
-        material->SetUniform("uSpotLights[" + std::to_string(index) + "].outerCutOff", OuterCutOff);
-        material->SetUniform("uSpotLights[" + std::to_string(index) + "].constant", Constant);
-        material->SetUniform("uSpotLights[" + std::to_string(index) + "].linear", Linear);
-        material->SetUniform("uSpotLights[" + std::to_string(index) + "].quadratic", Quadratic);
+        static const char* const members[] = {"position", "direction", "color", "intensity", "innerCutOff", "outerCutOff", "constant", "linear", "quadratic"};
+        static std::vector<std::vector<std::string>> nameCache;
+        const std::string* names = lightUniformNames(nameCache, "uSpotLights", members, index);
+
+        material->SetUniform(names[0], Position);
+        material->SetUniform(names[1], Direction);
+        material->SetUniform(names[2], LightColor);
+        material->SetUniform(names[3], Intensity);
+        material->SetUniform(names[4], InnerCutOff);
+        material->SetUniform(names[5], OuterCutOff);
+        material->SetUniform(names[6], Constant);
+        material->SetUniform(names[7], Linear);
+        material->SetUniform(names[8], Quadratic);
     }
 
     json SpotLight::ToJson(){
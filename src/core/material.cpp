@@ -24,12 +24,15 @@ namespace GLEP {
     Material::Material(std::shared_ptr<Material> material, bool copyUniforms){
         _name = material->GetName();
         _shader = material->GetShader();
+        _layeredShader = material->_layeredShader;
         LightingRequired = material->LightingRequired;
         ReceiveShadows = material->ReceiveShadows;
         CastShadows = material->CastShadows;
         BakeRequired = material->BakeRequired;
         Wireframe = material->Wireframe;
         CullFace = material->CullFace;
+        ShadowCaster = material->ShadowCaster;
+        _defaultVertexShader = material->_defaultVertexShader;
 
         if(copyUniforms)
             _uniforms = material->GetUniforms();
@@ -37,15 +40,31 @@ namespace GLEP {
 
     Material::Material(std::filesystem::path vsFilePath, std::filesystem::path fsFilePath){
         _shader = std::make_shared<Shader>(vsFilePath, fsFilePath);
+        setShaderDefaults();
     }
 
     Material::Material(std::shared_ptr<Shader> shader){
         _shader = shader;
+        setShaderDefaults();
     }
 
-    Material::~Material(){}
+    Material::~Material(){
+        DeferredGL::Cancel(this);
+    }
 
     void Material::Use(){ 
+        bind(_shader);
+    }
+
+    bool Material::UseLayered(){
+        std::shared_ptr<Shader> layeredShader = GetLayeredShader();
+        if(!layeredShader) return false;
+
+        bind(layeredShader);
+        return true;
+    }
+
+    void Material::bind(const std::shared_ptr<Shader>& shader){
         glPolygonMode(GL_FRONT_AND_BACK, Wireframe ? GL_LINE : GL_FILL);
         if(CullFace == MaterialCull::NONE) glDisable(GL_CULL_FACE);
         else{
@@ -53,19 +72,77 @@ namespace GLEP {
             glCullFace((GLenum)CullFace);
         }
 
-        _shader->Use();
+        shader->Use();
+        _activeShader = shader.get();
+        _boundCubeMaps = 0;
         
         for (auto& uniform : _uniforms) {
             uniform->SetUniform(this); 
         }
     }
 
+    void Material::setShaderDefaults(){
+        _defaultVertexShader = _shader && _shader->GetVsPath() == File::GLEP_SHADERS_PATH / "default.vs";
+
+        //A custom vertex stage may deform the geometry, only the material's own program casts the right shadow
+        ShadowCaster = _defaultVertexShader ? ShadowCasterMode::DEPTH_ONLY : ShadowCasterMode::MATERIAL;
+    }
+
+    bool Material::GetHasDefaultVertexShader(){ return _defaultVertexShader; }
+
+    std::shared_ptr<Shader> Material::GetLayeredShader(){
+        if(_layeredShader || !_shader) return _layeredShader;
+
+        //Only the built-in vertex stages have a known output layout to replicate across cube faces
+        std::filesystem::path vsPath = _shader->GetVsPath();
+        if(vsPath == File::GLEP_SHADERS_PATH / "default.vs"){
+            _layeredShader = std::make_shared<Shader>(
+                File::GLEP_SHADERS_PATH / "utility" / "cubeLayered.vs",
+                File::GLEP_SHADERS_PATH / "utility" / "cubeLayered.gs",
+                _shader->GetFsPath()
+            );
+        } else if(vsPath == File::GLEP_SHADERS_PATH / "skybox" / "skybox.vs"){
+            _layeredShader = std::make_shared<Shader>(
+                File::GLEP_SHADERS_PATH / "skybox" / "skyboxLayered.vs",
+                File::GLEP_SHADERS_PATH / "skybox" / "skyboxLayered.gs",
+                _shader->GetFsPath()
+            );
+        }
+
+        return _layeredShader;
+    }
+
+    void Material::AddUniform(const std::shared_ptr<TypelessShaderUniform>& uniform){
+        DeferredGL::Run(this, [this, uniform](){ uniform->SetUniform(this); });
+
+        _uniforms.push_back(uniform);
+    }
+
     std::vector<std::shared_ptr<TypelessShaderUniform>> Material::GetUniforms(){
         return _uniforms;
     }
 
+    std::shared_ptr<Texture> Material::GetDiffuseTexture(){
+        for(auto& u : _uniforms){
+            auto uniform = std::dynamic_pointer_cast<ShaderUniform<std::shared_ptr<Texture>>>(u);
+            if(uniform && uniform->Value && uniform->Value->GetType() == TextureType::DIFFUSE){
+                return uniform->Value;
+            }
+        }
+
+        return nullptr;
+    }
+
+    const std::string& Material::memberName(const std::string& name, const char* member){
+        //Reuses one buffer so struct uniforms don't allocate a new name every bind
+        _memberName.assign(name);
+        _memberName.append(member);
+        return _memberName;
+    }
+
     GLint Material::GetUniformLocation(const std::string &name){
-        return glGetUniformLocation(_shader->GetID(), name.c_str());
+        Shader* shader = _activeShader ? _activeShader : _shader.get();
+        return glGetUniformLocation(shader->GetID(), name.c_str());
     }
 
     void Material::SetUniform(const std::string &name, bool value){         
@@ -159,6 +236,9 @@ namespace GLEP {
     template <>
     json ShaderUniform<std::shared_ptr<CubeMap>>::ToJson(){
         json j;
+        if(_isPrivate)
+            return j;
+
         j[Name] = Value->ToJson();
         return j;
     }
@@ -180,6 +260,7 @@ namespace GLEP {
         j["cast_shadows"] = CastShadows;
         j["receive_shadows"] = ReceiveShadows;
         j["cull_face"] = CullFace;
+        j["shadow_caster"] = ShadowCaster;
 
         if(_name == "material"){
             j["shader"]["vsPath"] = _shader->GetVsPath();
@@ -188,7 +269,9 @@ namespace GLEP {
 
         j["uniforms"] = json();
         for(auto& u : _uniforms){
-            j["uniforms"][u->Name] = u->ToJson()[u->Name];
+            json uniform = u->ToJson();
+            if(!uniform.contains(u->Name)) continue;
+            j["uniforms"][u->Name] = uniform[u->Name];
         }
         return j;
     }
@@ -227,6 +310,8 @@ namespace GLEP {
             result->CastShadows = data["cast_shadows"];
             result->ReceiveShadows = data["receive_shadows"];
             result->CullFace = (MaterialCull) data["cull_face"];
+            if(data.contains("shadow_caster"))
+                result->ShadowCaster = (ShadowCasterMode) data["shadow_caster"];
         }
 
         return result;
@@ -241,10 +326,10 @@ namespace GLEP {
 
     void Material::SetUniform(const std::string &name, std::shared_ptr<TextureMap> value){
         if(value){
-            glUniform1i(GetUniformLocation(name + ".diffuseTex"), 0);
-            glUniform1i(GetUniformLocation(name + ".specularTex"), 1);
-            glUniform1i(GetUniformLocation(name + ".normalTex"), 2);
-            glUniform1i(GetUniformLocation(name + ".heightTex"), 3);
+            glUniform1i(GetUniformLocation(memberName(name, ".diffuseTex")), 0);
+            glUniform1i(GetUniformLocation(memberName(name, ".specularTex")), 1);
+            glUniform1i(GetUniformLocation(memberName(name, ".normalTex")), 2);
+            glUniform1i(GetUniformLocation(memberName(name, ".heightTex")), 3);
 
             value->Bind();
         }
@@ -252,15 +337,17 @@ namespace GLEP {
 
     void Material::SetUniform(const std::string &name, std::shared_ptr<CubeMap> value){
         if(value){
-            glUniform1i(GetUniformLocation(name), 6); 
-            value->Bind();
+            //Cube maps take consecutive units from 6 so blended probes can be sampled together
+            int unit = 6 + std::min(_boundCubeMaps++, 9);
+            glUniform1i(GetUniformLocation(name), unit); 
+            value->Bind(unit);
         }
     }
 
     void Material::SetUniform(const std::string &name, std::shared_ptr<Framebuffer> value){
         if(value){
-            glUniform1i(GetUniformLocation(name + ".color"), 4);
-            glUniform1i(GetUniformLocation(name + ".depth"), 5);
+            glUniform1i(GetUniformLocation(memberName(name, ".color")), 4);
+            glUniform1i(GetUniformLocation(memberName(name, ".depth")), 5);
             value->BindResult();
         }
     }
@@ -272,6 +359,21 @@ namespace GLEP {
 
     bool TypelessShaderUniform::GetIsPrivate(){ return _isPrivate; }
 
+    ShaderUniformAlias::ShaderUniformAlias(std::string name, std::shared_ptr<TypelessShaderUniform> source)
+    : TypelessShaderUniform(name, true){
+        Source = source;
+    }
+
+    void ShaderUniformAlias::SetUniform(Material* material){
+        Source->SetUniform(material, Name);
+    }
+
+    void ShaderUniformAlias::SetUniform(Material* material, const std::string& name){
+        Source->SetUniform(material, name);
+    }
+
+    json ShaderUniformAlias::ToJson(){ return json(); }
+
     std::shared_ptr<Shader> Material::GetShader() { return _shader; }
     std::string Material::GetName() { return _name; }
 
@@ -330,6 +432,8 @@ namespace GLEP {
         _name = "reflection_material";
         BakeRequired = cubeMap == nullptr;
         AddUniform<std::shared_ptr<CubeMap>>("uMaterial.cubeMap", cubeMap);
+        AddUniform<std::shared_ptr<CubeMap>>("uMaterial.blendCubeMap", cubeMap, true);
+        AddUniform<float>("uMaterial.blend", 0.0f, true);
         AddUniform<Color>("uMaterial.tint", tint);
     }
 
@@ -348,6 +452,8 @@ namespace GLEP {
         _name = "refraction_material";
         BakeRequired = cubeMap == nullptr;
         AddUniform<std::shared_ptr<CubeMap>>("uMaterial.cubeMap", cubeMap);
+        AddUniform<std::shared_ptr<CubeMap>>("uMaterial.blendCubeMap", cubeMap, true);
+        AddUniform<float>("uMaterial.blend", 0.0f, true);
         AddUniform<float>("uMaterial.refractiveIndex", refractiveIndex);
         AddUniform<Color>("uMaterial.tint", tint);
     }
@@ -40,13 +40,32 @@ namespace GLEP{
     void Model::CalculateNormals(){
         _calculateNormalsNeeded = false;
 
-        for(std::shared_ptr<Mesh> m : _meshes){
+        for(const std::shared_ptr<Mesh>& m : _meshes){
             m->GeometryData->CalculateNormals();
         }
 
     }
 
-    std::vector<std::shared_ptr<Mesh>> Model::GetMeshes(){ return _meshes; }
+    const std::vector<std::shared_ptr<Mesh>>& Model::GetMeshes(){ return _meshes; }
+
+    bool Model::GetLocalBounds(AABB& bounds){
+        bounds = AABB();
+        for(std::shared_ptr<Mesh>& m : _meshes){
+            if(!m->GeometryData) continue;
+            bounds.Expand(AABB(m->GeometryData->GetBoundsMin(), m->GeometryData->GetBoundsMax()));
+        }
+
+        return bounds.IsValid();
+    }
+
+    unsigned int Model::GetBoundsRevision(){
+        unsigned int revision = 0;
+        for(std::shared_ptr<Mesh>& m : _meshes){
+            revision = revision * 31u + (m->GeometryData ? m->GeometryData->GetBoundsRevision() : 0u);
+        }
+
+        return revision;
+    }
 
     json Model::ToJson(){
         json j;
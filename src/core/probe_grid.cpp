@@ -0,0 +1,133 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <GLEP/core/probe_grid.hpp>
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+namespace GLEP {
+
+    ProbeGrid::ProbeGrid(){}
+
+    float ProbeGrid::GetCellSize(){ return _cellSize; }
+    int ProbeGrid::GetCellCount(){ return (int)_cells.size(); }
+
+    glm::ivec3 ProbeGrid::cellOf(glm::vec3 position){
+        return glm::ivec3(glm::floor(position / _cellSize));
+    }
+
+    int64_t ProbeGrid::cellKey(glm::ivec3 cell){
+        const int64_t offset = 1 << 20;
+        const int64_t mask = (1 << 21) - 1;
+        return (((int64_t)cell.x + offset) & mask) << 42 | (((int64_t)cell.y + offset) & mask) << 21 | (((int64_t)cell.z + offset) & mask);
+    }
+
+    void ProbeGrid::Build(const std::vector<std::shared_ptr<BakedCubeMap>>& probes){
+        _probes.clear();
+        _positions.clear();
+        _cells.clear();
+
+        if(probes.empty()) return;
+
+        glm::vec3 boundsMin = probes[0]->GetPosition();
+        glm::vec3 boundsMax = boundsMin;
+        for(const std::shared_ptr<BakedCubeMap>& p : probes){
+            _probes.push_back(p.get());
+            _positions.push_back(p->GetPosition());
+            boundsMin = glm::min(boundsMin, _positions.back());
+            boundsMax = glm::max(boundsMax, _positions.back());
+        }
+
+        //Aim for roughly one probe per cell
+        glm::vec3 extent = boundsMax - boundsMin;
+        float largest = std::max(extent.x, std::max(extent.y, extent.z));
+        _cellSize = largest > 0.0f ? std::max(largest / std::cbrt((float)probes.size()), 0.001f) : 1.0f;
+
+        _minCell = cellOf(boundsMin);
+        _maxCell = cellOf(boundsMax);
+        for(int i = 0; i < _positions.size(); i++){
+            _cells[cellKey(cellOf(_positions[i]))].push_back(i);
+        }
+    }
+
+    bool ProbeGrid::IsOutdated(const std::vector<std::shared_ptr<BakedCubeMap>>& probes){
+        if(probes.size() != _probes.size()) return true;
+
+        for(int i = 0; i < probes.size(); i++){
+            if(probes[i].get() != _probes[i] || probes[i]->GetPosition() != _positions[i])
+                return true;
+        }
+
+        return false;
+    }
+
+    int ProbeGrid::FindNearest(glm::vec3 position, int& second, float& nearestDistance, float& secondDistance){
+        int nearest = -1;
+        second = -1;
+        nearestDistance = FLT_MAX;
+        secondDistance = FLT_MAX;
+
+        if(_positions.empty()) return -1;
+
+        glm::ivec3 center = cellOf(position);
+
+        //Rings closer than the grid bounds are empty, rings past the furthest bound can't contain probes
+        glm::ivec3 outside = glm::max(glm::max(_minCell - center, center - _maxCell), glm::ivec3(0));
+        glm::ivec3 furthest = glm::max(glm::abs(center - _minCell), glm::abs(center - _maxCell));
+        int firstRing = std::max(outside.x, std::max(outside.y, outside.z));
+        int lastRing = std::max(furthest.x, std::max(furthest.y, furthest.z));
+
+        for(int ring = firstRing; ring <= lastRing; ring++){
+            //Every cell in this ring is at least (ring - 1) cells away
+            if(second >= 0 && (ring - 1) * _cellSize > secondDistance) break;
+
+            glm::ivec3 from = glm::max(center - ring, _minCell);
+            glm::ivec3 to = glm::min(center + ring, _maxCell);
+
+            for(int x = from.x; x <= to.x; x++){
+                for(int y = from.y; y <= to.y; y++){
+                    for(int z = from.z; z <= to.z; z++){
+                        glm::ivec3 offset = glm::abs(glm::ivec3(x, y, z) - center);
+                        if(std::max(offset.x, std::max(offset.y, offset.z)) != ring) continue;
+
+                        auto cell = _cells.find(cellKey(glm::ivec3(x, y, z)));
+                        if(cell == _cells.end()) continue;
+
+                        for(int index : cell->second){
+                            float distance = glm::distance(position, _positions[index]);
+                            if(distance < nearestDistance){
+                                second = nearest;
+                                secondDistance = nearestDistance;
+                                nearest = index;
+                                nearestDistance = distance;
+                            } else if(distance < secondDistance){
+                                second = index;
+                                secondDistance = distance;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        return nearest;
+    }
+
+}
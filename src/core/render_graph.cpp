@@ -0,0 +1,220 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <GLEP/core/render_graph.hpp>
+
+namespace GLEP {
+
+    void RenderGraph::Clear(){
+        _resources.clear();
+        _passes.clear();
+        _compiled = false;
+    }
+
+    RenderGraphResource RenderGraph::CreateTarget(const std::string& name, glm::vec2 resolution, const FramebufferDesc& desc){
+        _resources.push_back({name, resolution, desc, false, nullptr, -1, -1, -1});
+        _compiled = false;
+        return (RenderGraphResource)_resources.size() - 1;
+    }
+
+    RenderGraphResource RenderGraph::ImportTarget(const std::string& name, const std::shared_ptr<Framebuffer>& target, glm::vec2 resolution){
+        FramebufferDesc desc;
+        if(target){
+            resolution = glm::vec2(target->GetWidth(), target->GetHeight());
+            desc = target->GetDesc();
+        }
+        _resources.push_back({name, resolution, desc, true, target, -1, -1, -1});
+        _compiled = false;
+        return (RenderGraphResource)_resources.size() - 1;
+    }
+
+    void RenderGraph::AddPass(const std::string& name, const std::vector<RenderGraphResource>& reads, RenderGraphResource target, ExecuteFunc execute){
+        _passes.push_back({name, reads, target, execute, false, false});
+        _compiled = false;
+    }
+
+    void RenderGraph::cullPasses(){
+        //Walk backwards from the imported targets, keeping only passes whose result is read by a kept pass
+        std::vector<bool> required(_resources.size(), false);
+        for(int i = 0; i < _resources.size(); i++)
+            required[i] = _resources[i].Imported;
+
+        for(int i = (int)_passes.size() - 1; i >= 0; i--){
+            Pass& pass = _passes[i];
+            pass.Culled = !required[pass.Target];
+            if(pass.Culled) continue;
+
+            for(RenderGraphResource r : pass.Reads)
+                required[r] = true;
+        }
+    }
+
+    int RenderGraph::acquireTarget(glm::vec2 resolution, const FramebufferDesc& desc){
+        for(int i = 0; i < _pool.size(); i++){
+            PooledTarget& pooled = _pool[i];
+            if(pooled.InUse) continue;
+            if(pooled.Target->GetWidth() != (int)resolution.x || pooled.Target->GetHeight() != (int)resolution.y) continue;
+            if(pooled.Target->GetDesc() != desc) continue;
+
+            pooled.InUse = true;
+            pooled.Used = true;
+            return i;
+        }
+
+        //A target left over from a previous graph, e.g. before a resize, has its storage resized rather than being replaced
+        for(int i = 0; i < _pool.size(); i++){
+            PooledTarget& pooled = _pool[i];
+            if(pooled.InUse || pooled.Used || pooled.Target->GetDesc() != desc) continue;
+
+            pooled.Target->SetResolution(resolution);
+            pooled.InUse = true;
+            pooled.Used = true;
+            return i;
+        }
+
+        _pool.push_back({std::make_shared<Framebuffer>(resolution, desc), true, true});
+        return (int)_pool.size() - 1;
+    }
+
+    void RenderGraph::allocateTargets(){
+        for(Resource& resource : _resources){
+            resource.FirstUse = -1;
+            resource.LastUse = -1;
+            if(!resource.Imported){
+                resource.Target = nullptr;
+                resource.PoolIndex = -1;
+            }
+        }
+
+        for(int i = 0; i < _passes.size(); i++){
+            if(_passes[i].Culled) continue;
+
+            auto use = [&](RenderGraphResource r){
+                Resource& resource = _resources[r];
+                if(resource.FirstUse < 0) resource.FirstUse = i;
+                resource.LastUse = i;
+            };
+
+            use(_passes[i].Target);
+            for(RenderGraphResource r : _passes[i].Reads)
+                use(r);
+        }
+
+        for(PooledTarget& pooled : _pool){
+            pooled.InUse = false;
+            pooled.Used = false;
+        }
+
+        //A target returns to the pool after its last reader, so the next target to start can alias it
+        for(int i = 0; i < _passes.size(); i++){
+            if(_passes[i].Culled) continue;
+
+            for(Resource& resource : _resources){
+                if(resource.Imported || resource.FirstUse != i) continue;
+                resource.PoolIndex = acquireTarget(resource.Resolution, resource.Desc);
+                resource.Target = _pool[resource.PoolIndex].Target;
+            }
+
+            for(Resource& resource : _resources){
+                if(resource.Imported || resource.LastUse != i) continue;
+                _pool[resource.PoolIndex].InUse = false;
+            }
+        }
+
+        //Targets no longer needed by this graph (e.g. after a resolution change) are released
+        _pool.erase(std::remove_if(_pool.begin(), _pool.end(), [](const PooledTarget& pooled){ return !pooled.Used; }), _pool.end());
+        for(Resource& resource : _resources){
+            if(resource.Imported || !resource.Target) continue;
+            for(int i = 0; i < _pool.size(); i++){
+                if(_pool[i].Target == resource.Target) resource.PoolIndex = i;
+            }
+        }
+    }
+
+    void RenderGraph::resolveTargets(){
+        //A multisampled target is resolved once the next pass touching it only reads it, not after every pass drawing on top
+        for(int i = 0; i < _passes.size(); i++){
+            Pass& pass = _passes[i];
+            pass.Resolve = false;
+            if(pass.Culled || _resources[pass.Target].Desc.Samples <= 1) continue;
+
+            for(int j = i + 1; j < _passes.size(); j++){
+                const Pass& next = _passes[j];
+                if(next.Culled) continue;
+                if(next.Target == pass.Target) break;
+
+                if(std::find(next.Reads.begin(), next.Reads.end(), pass.Target) != next.Reads.end()){
+                    pass.Resolve = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    void RenderGraph::Compile(){
+        cullPasses();
+        allocateTargets();
+        resolveTargets();
+
+        _stats = RenderGraphStats();
+        for(const Pass& pass : _passes){
+            if(pass.Culled) _stats.CulledPasses++;
+            else _stats.Passes++;
+        }
+
+        for(const Resource& resource : _resources){
+            if(!resource.Imported) _stats.TransientResources++;
+        }
+
+        _stats.AllocatedTargets = (int)_pool.size();
+        for(const PooledTarget& pooled : _pool)
+            _stats.AllocatedBytes += pooled.Target->GetAllocatedBytes();
+
+        _compiled = true;
+    }
+
+    void RenderGraph::Execute(){
+        if(!_compiled) Compile();
+
+        for(Pass& pass : _passes){
+            if(pass.Culled) continue;
+
+            const Resource& resource = _resources[pass.Target];
+            if(resource.Target) resource.Target->Bind();
+            else glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+            if(resource.Resolution.x > 0.0f && resource.Resolution.y > 0.0f)
+                glViewport(0, 0, (int)resource.Resolution.x, (int)resource.Resolution.y);
+
+            pass.Execute(*this);
+
+            if(pass.Resolve) resource.Target->Resolve();
+        }
+    }
+
+    const std::shared_ptr<Framebuffer>& RenderGraph::GetFramebuffer(RenderGraphResource resource){
+        return _resources[resource].Target;
+    }
+
+    glm::vec2 RenderGraph::GetResolution(RenderGraphResource resource){
+        return _resources[resource].Resolution;
+    }
+
+    RenderGraphStats RenderGraph::GetStats(){ return _stats; }
+
+}
@@ -43,7 +43,45 @@ namespace GLEP{
         glCullFace(GL_FRONT);
         glFrontFace(GL_CCW); 
 
-        _shadowMapBuffer = std::make_shared<Framebuffer>(glm::vec2(1024)); 
+        FramebufferDesc shadowMapDesc;
+        shadowMapDesc.Color = FramebufferColor::NONE;
+        _shadowMapBuffer = std::make_shared<Framebuffer>(glm::vec2(1024), shadowMapDesc); 
+        _staticShadowMapBuffer = std::make_shared<Framebuffer>(glm::vec2(1024), shadowMapDesc);
+
+        _shadowCasterShader = std::make_shared<Shader>(
+            File::GLEP_SHADERS_PATH / "utility" / "shadowCaster.vs",
+            File::GLEP_SHADERS_PATH / "utility" / "shadowCaster.fs"
+        );
+        _shadowCasterModelLoc = glGetUniformLocation(_shadowCasterShader->GetID(), "model");
+        _shadowCasterLightSpaceLoc = glGetUniformLocation(_shadowCasterShader->GetID(), "lightSpaceMatrix");
+
+        _shadowCasterAlphaShader = std::make_shared<Shader>(
+            File::GLEP_SHADERS_PATH / "utility" / "shadowCaster.vs",
+            File::GLEP_SHADERS_PATH / "utility" / "shadowCasterAlpha.fs"
+        );
+        _shadowCasterAlphaModelLoc = glGetUniformLocation(_shadowCasterAlphaShader->GetID(), "model");
+        _shadowCasterAlphaLightSpaceLoc = glGetUniformLocation(_shadowCasterAlphaShader->GetID(), "lightSpaceMatrix");
+        _shadowCasterAlphaTexLoc = glGetUniformLocation(_shadowCasterAlphaShader->GetID(), "uAlphaTex");
+
+        _depthPrePassShader = std::make_shared<Shader>(
+            File::GLEP_SHADERS_PATH / "utility" / "depthPrePass.vs",
+            File::GLEP_SHADERS_PATH / "utility" / "shadowCaster.fs"
+        );
+        _depthPrePassModelLoc = glGetUniformLocation(_depthPrePassShader->GetID(), "model");
+        _depthPrePassViewLoc = glGetUniformLocation(_depthPrePassShader->GetID(), "view");
+        _depthPrePassProjectionLoc = glGetUniformLocation(_depthPrePassShader->GetID(), "projection");
+
+        _depthPrePassAlphaShader = std::make_shared<Shader>(
+            File::GLEP_SHADERS_PATH / "utility" / "depthPrePass.vs",
+            File::GLEP_SHADERS_PATH / "utility" / "shadowCasterAlpha.fs"
+        );
+        _depthPrePassAlphaModelLoc = glGetUniformLocation(_depthPrePassAlphaShader->GetID(), "model");
+        _depthPrePassAlphaViewLoc = glGetUniformLocation(_depthPrePassAlphaShader->GetID(), "view");
+        _depthPrePassAlphaProjectionLoc = glGetUniformLocation(_depthPrePassAlphaShader->GetID(), "projection");
+        _depthPrePassAlphaTexLoc = glGetUniformLocation(_depthPrePassAlphaShader->GetID(), "uAlphaTex");
+
+        glGenQueries(4, &_prePassQueries[0][0]);
+        glGenQueries(3, _frameTimeQueries);
         _shadowMapCamera = std::make_shared<OrthographicCamera>(10.0f, 1.0f, 0.01f, 10.0f);
 
         Print(PrintCode::INFO, "RENDERER", "Renderer successfully initialized - OpenGL version " + std::to_string(GL_MAJ_VERSION) + std::to_string(GL_MIN_VERSION) + "0");
@@ -52,6 +90,9 @@ namespace GLEP{
     }
 
     Renderer::~Renderer(){
+        glDeleteQueries(4, &_prePassQueries[0][0]);
+        glDeleteQueries(3, _frameTimeQueries);
+
         if(!_isGuiShutdown && _isGuiInitalized){
             ImGui_ImplOpenGL3_Shutdown();
             ImGui_ImplGlfw_Shutdown();
@@ -102,6 +143,21 @@ namespace GLEP{
 
     std::shared_ptr<Camera> Renderer::GetShadowMapCamera(){ return _shadowMapCamera;}
     std::shared_ptr<Framebuffer> Renderer::GetShadowMapBuffer(){ return _shadowMapBuffer; }
+    std::shared_ptr<Framebuffer> Renderer::GetStaticShadowMapBuffer(){ return _staticShadowMapBuffer; }
+    RenderGraphStats Renderer::GetFrameGraphStats(){ return _frameGraph.GetStats(); }
+    RenderScaleStats Renderer::GetRenderScaleStats(){ return _renderScaleStats; }
+    ShadowCacheStats Renderer::GetShadowCacheStats(){ return _shadowCacheStats; }
+    ProbeUpdateStats Renderer::GetProbeUpdateStats(){ return _probeUpdateStats; }
+    DepthPrePassStats Renderer::GetDepthPrePassStats(){ return _depthPrePassStats; }
+    AllocationStats Renderer::GetFrameAllocationStats(){ return _frameAllocationStats; }
+
+    void Renderer::InvalidateShadowCache(){
+        _shadowCacheInvalidated = true;
+    }
+
+    bool Renderer::isShadowPass(RenderType type){
+        return type == RenderType::SHADOW_MAP_STATIC || type == RenderType::SHADOW_MAP_DYNAMIC;
+    }
 
     void Renderer::SetViewport(int x, int y, int width, int height){
         glViewport(x,y,width,height);
@@ -112,7 +168,7 @@ namespace GLEP{
         glViewport(0,0, (int)resolution.x, (int)resolution.y);
     }
 
-    void Renderer::renderSceneObjects(std::shared_ptr<Scene> scene, std::shared_ptr<Camera> camera, RenderType type){
+    void Renderer::renderSceneObjects(const std::shared_ptr<Scene>& scene, const std::shared_ptr<Camera>& camera, RenderType type){
         glClearColor(ClearColor.r, ClearColor.g, ClearColor.b, ClearColor.a);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -120,37 +176,168 @@ namespace GLEP{
         glm::mat4 viewMatrix = camera->GetViewMatrix();
         glm::vec3 cameraPos = camera->GetWorldPosition();
 
-        for(std::shared_ptr<SceneObject> object : scene->GetObjects()){
-            std::shared_ptr<Model> model = std::dynamic_pointer_cast<Model>(object);
+        _visibleObjects.clear();
+        if(type == RenderType::NORMAL && FrustumCulling)
+            cullSceneObjects(scene, projectionMatrix, viewMatrix);
 
-            if(!model) continue;
+        if(type == RenderType::NORMAL && DepthPrePass){
+            renderWithDepthPrePass(scene, cameraPos, projectionMatrix, viewMatrix);
+            return;
+        }
+
+        for(const std::shared_ptr<Model>& model : scene->GetModels()){
+            if(type == RenderType::NORMAL && isCulled(scene, model.get())) continue;
 
             glm::mat4 modelMatrix = model->GetModelMatrix();
-            for(std::shared_ptr<Mesh> m : model->GetMeshes()){
+            for(const std::shared_ptr<Mesh>& m : model->GetMeshes()){
                 if(type == RenderType::BAKE && m->MaterialData->BakeRequired)
                     continue;
-
-                if(type == RenderType::SHADOW_MAP && !m->MaterialData->CastShadows)
-                    continue;
                 
                 renderMesh(m->GeometryData, m->MaterialData, scene, cameraPos, projectionMatrix, viewMatrix, modelMatrix, type);
             }
         }
     }
 
-    void Renderer::renderMesh(std::shared_ptr<Geometry> geo, std::shared_ptr<Material> mat, std::shared_ptr<Scene> scene, glm::vec3 cameraPos, glm::mat4 projection, glm::mat4 view, glm::mat4 model, RenderType type){
+    void Renderer::cullSceneObjects(const std::shared_ptr<Scene>& scene, glm::mat4 projection, glm::mat4 view){
+        _visibleObjects.clear();
+        scene->GetBVH().QueryFrustum(Frustum::FromMatrix(projection * view), _visibleObjects);
+
+        //Sorted for lookups, a hash set would allocate a node per visible object every frame
+        std::sort(_visibleObjects.begin(), _visibleObjects.end());
+    }
+
+    bool Renderer::isCulled(const std::shared_ptr<Scene>& scene, SceneObject* object){
+        if(!FrustumCulling || std::binary_search(_visibleObjects.begin(), _visibleObjects.end(), object)) return false;
+
+        //Objects added without going through Scene::Add aren't tracked by the BVH and are always drawn
+        return scene->GetBVH().GetBounds(object) != nullptr;
+    }
+
+    void Renderer::renderWithDepthPrePass(const std::shared_ptr<Scene>& scene, glm::vec3 cameraPos, glm::mat4 projection, glm::mat4 view){
+        _prePassDraws.clear();
+        _prePassAlphaDraws.clear();
+        _forwardDraws.clear();
+
+        for(const std::shared_ptr<Model>& model : scene->GetModels()){
+            if(isCulled(scene, model.get())) continue;
+
+            glm::mat4 modelMatrix = model->GetModelMatrix();
+            for(const std::shared_ptr<Mesh>& m : model->GetMeshes()){
+                std::shared_ptr<Material> mat = m->MaterialData;
+
+                //Wireframe and custom vertex programs can't reproduce the pre-pass depth exactly, whatever their shadow caster mode
+                if(mat->Wireframe || !mat->GetHasDefaultVertexShader() || mat->ShadowCaster == ShadowCasterMode::MATERIAL){
+                    _forwardDraws.push_back({m.get(), modelMatrix});
+                } else if(mat->ShadowCaster == ShadowCasterMode::ALPHA_TESTED && mat->GetDiffuseTexture()){
+                    _prePassAlphaDraws.push_back({m.get(), modelMatrix});
+                } else {
+                    _prePassDraws.push_back({m.get(), modelMatrix});
+                }
+            }
+        }
+
+        int queryIndex = _prePassQueryFrame % 2;
+        readDepthPrePassQueries(queryIndex);
+
+        /* DEPTH PRE-PASS */
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        glBeginQuery(GL_SAMPLES_PASSED, _prePassQueries[queryIndex][0]);
+
+        if(!_prePassDraws.empty()){
+            _depthPrePassShader->Use();
+            glUniformMatrix4fv(_depthPrePassProjectionLoc, 1, GL_FALSE, glm::value_ptr(projection));
+            glUniformMatrix4fv(_depthPrePassViewLoc, 1, GL_FALSE, glm::value_ptr(view));
+
+            for(const MeshDraw& draw : _prePassDraws){
+                drawDepthOnly(draw, _depthPrePassModelLoc, (GLenum)draw.MeshData->MaterialData->CullFace);
+            }
+        }
+
+        if(!_prePassAlphaDraws.empty()){
+            _depthPrePassAlphaShader->Use();
+            glUniformMatrix4fv(_depthPrePassAlphaProjectionLoc, 1, GL_FALSE, glm::value_ptr(projection));
+            glUniformMatrix4fv(_depthPrePassAlphaViewLoc, 1, GL_FALSE, glm::value_ptr(view));
+            glUniform1i(_depthPrePassAlphaTexLoc, (int)TextureType::DIFFUSE);
+
+            for(const MeshDraw& draw : _prePassAlphaDraws){
+                draw.MeshData->MaterialData->GetDiffuseTexture()->Bind();
+                drawDepthOnly(draw, _depthPrePassAlphaModelLoc, (GLenum)draw.MeshData->MaterialData->CullFace);
+            }
+        }
+
+        glEndQuery(GL_SAMPLES_PASSED);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+        /* SHADING PASS */
+        glDepthFunc((GLenum)PrePassDepthTest);
+        glDepthMask(GL_FALSE);
+        glBeginQuery(GL_SAMPLES_PASSED, _prePassQueries[queryIndex][1]);
+
+        for(const MeshDraw& draw : _prePassDraws){
+            renderMesh(draw.MeshData->GeometryData, draw.MeshData->MaterialData, scene, cameraPos, projection, view, draw.ModelMatrix, RenderType::NORMAL);
+        }
+
+        for(const MeshDraw& draw : _prePassAlphaDraws){
+            renderMesh(draw.MeshData->GeometryData, draw.MeshData->MaterialData, scene, cameraPos, projection, view, draw.ModelMatrix, RenderType::NORMAL);
+        }
+
+        glEndQuery(GL_SAMPLES_PASSED);
+        _prePassQueriesIssued[queryIndex] = true;
+        _prePassQueryFrame++;
+
+        glDepthMask(GL_TRUE);
+        glDepthFunc(GL_LESS);
+
+        for(const MeshDraw& draw : _forwardDraws){
+            renderMesh(draw.MeshData->GeometryData, draw.MeshData->MaterialData, scene, cameraPos, projection, view, draw.ModelMatrix, RenderType::NORMAL);
+        }
+    }
+
+    void Renderer::readDepthPrePassQueries(int index){
+        if(!_prePassQueriesIssued[index]) return;
+
+        //Results are read two frames late so the query never stalls the pipeline
+        GLuint prePassAvailable = 0;
+        GLuint shadedAvailable = 0;
+        glGetQueryObjectuiv(_prePassQueries[index][0], GL_QUERY_RESULT_AVAILABLE, &prePassAvailable);
+        glGetQueryObjectuiv(_prePassQueries[index][1], GL_QUERY_RESULT_AVAILABLE, &shadedAvailable);
+        if(!prePassAvailable || !shadedAvailable) return;
+
+        GLuint prePassFragments = 0;
+        GLuint shadedFragments = 0;
+        glGetQueryObjectuiv(_prePassQueries[index][0], GL_QUERY_RESULT, &prePassFragments);
+        glGetQueryObjectuiv(_prePassQueries[index][1], GL_QUERY_RESULT, &shadedFragments);
+
+        _depthPrePassStats.PrePassFragments = prePassFragments;
+        _depthPrePassStats.ShadedFragments = shadedFragments;
+        _depthPrePassStats.FragmentsSaved = prePassFragments > shadedFragments ? prePassFragments - shadedFragments : 0;
+    }
+
+    void Renderer::renderMesh(const std::shared_ptr<Geometry>& geo, const std::shared_ptr<Material>& mat, const std::shared_ptr<Scene>& scene, glm::vec3 cameraPos, glm::mat4 projection, glm::mat4 view, glm::mat4 model, RenderType type){
         mat->Use();
 
         //Override MaterialCull when rendering shadow map
-        if(type == RenderType::SHADOW_MAP)
+        if(isShadowPass(type))
             glCullFace(GL_BACK);
 
+        setMeshUniforms(mat, scene, cameraPos, projection, view, model);
+        geo->Draw();
+    }
+
+    void Renderer::setMeshUniforms(const std::shared_ptr<Material>& mat, const std::shared_ptr<Scene>& scene, glm::vec3 cameraPos, glm::mat4 projection, glm::mat4 view, glm::mat4 model){
+        //Names past the small string buffer would otherwise be allocated for every draw
+        static const std::string lightSpaceMatrixName = "lightSpaceMatrix";
+        static const std::string ambientLightSetName = "uAmbientLightSet";
+        static const std::string directionalLightSetName = "uDirectionalLightSet";
+        static const std::string directionalLightPositionName = "uDirectionalLight.position";
+
         mat->SetUniform("projection", glm::value_ptr(projection));
         mat->SetUniform("view", glm::value_ptr(view));
         mat->SetUniform("model", glm::value_ptr(model));
 
         if(RenderShadows && mat->ReceiveShadows)
-            mat->SetUniform("lightSpaceMatrix", glm::value_ptr(_lightSpaceMatrix));
+            mat->SetUniform(lightSpaceMatrixName, glm::value_ptr(_lightSpaceMatrix));
             mat->SetUniform("uShadowMap", _shadowMapBuffer);
 
         mat->SetUniform("viewPos", cameraPos);
@@ -160,46 +347,44 @@ namespace GLEP{
         if(mat->LightingRequired){
 
             SceneLightData lightData = scene->GetLightData();
-            mat->SetUniform("uAmbientLightSet", lightData.AmbientLight);
-            mat->SetUniform("uDirectionalLightSet", lightData.DirectionalLight);
+            mat->SetUniform(ambientLightSetName, lightData.AmbientLight);
+            mat->SetUniform(directionalLightSetName, lightData.DirectionalLight);
             mat->SetUniform("uPointLightsAmt", lightData.PointLightsAmt);
             mat->SetUniform("uSpotLightsAmt", lightData.SpotLightsAmt);
 
             int pointIndex = 0;
             int spotIndex = 0;
 
-            auto dirLight = scene->GetDirectionalLight();
+            const std::shared_ptr<DirectionalLight>& dirLight = scene->GetDirectionalLight();
 
-            for(int i = 0; i < scene->GetLights().size(); i++){
-                switch(scene->GetLight(i)->GetType()){
+            for(const std::shared_ptr<Light>& light : scene->GetLights()){
+                switch(light->GetType()){
                     case LightType::AMBIENT:
-                        scene->GetLight(i)->Bind(mat, 0);
+                        light->Bind(mat, 0);
                         break;
                     
                     case LightType::DIRECTION:
                         if(RenderShadows)
-                            mat->SetUniform("uDirectionalLight.position", ShadowMapDistance * -dirLight->Direction);
-                        scene->GetLight(i)->Bind(mat, 0);
+                            mat->SetUniform(directionalLightPositionName, ShadowMapDistance * -dirLight->Direction);
+                        light->Bind(mat, 0);
                         break;
 
                     case LightType::POINT:
-                        scene->GetLight(i)->Bind(mat, pointIndex);
+                        light->Bind(mat, pointIndex);
                         pointIndex++;
                         break;
 
                     case LightType::SPOT:
-                        scene->GetLight(i)->Bind(mat, spotIndex);
+                        light->Bind(mat, spotIndex);
                         spotIndex++;
                         break;
                 }
                 
             }
         }
-        
-        geo->Draw();
     }
 
-    void Renderer::renderSkybox(std::shared_ptr<Scene> scene, std::shared_ptr<Camera> camera, bool depthTest){
+    void Renderer::renderSkybox(const std::shared_ptr<Scene>& scene, const std::shared_ptr<Camera>& camera, bool depthTest){
         if(scene->Skybox){
             glm::mat4 view = glm::mat4(glm::mat3(camera->GetViewMatrix()));  
             glm::mat4 projection = camera->GetProjectionMatrix();
@@ -219,18 +404,25 @@ namespace GLEP{
     void Renderer::Bake(std::shared_ptr<Scene> scene){
         scene->UpdateObjects();
 
-        for(std::shared_ptr<BakedCubeMap> cubeMap : scene->GetBakedCubeMaps()){
+        for(const std::shared_ptr<BakedCubeMap>& cubeMap : scene->GetBakedCubeMaps()){
             SetViewport(0,0,cubeMap->GetFramebuffer()->GetWidth(), cubeMap->GetFramebuffer()->GetHeight());
 
-            for(int i = 0; i < 6; i++){
-                cubeMap->SetDirection(i);
-                cubeMap->BindBuffer(i);
+            if(LayeredBake && cubeMap->BindLayeredBuffer()){
+                renderLayeredCubeMap(scene, cubeMap);
+            } else {
+                for(int i = 0; i < 6; i++){
+                    cubeMap->SetDirection(i);
+                    cubeMap->BindBuffer(i);
 
-                renderSceneObjects(scene, cubeMap->GetCamera(), RenderType::BAKE);
-                renderSkybox(scene, cubeMap->GetCamera(), false);
+                    renderSceneObjects(scene, cubeMap->GetCamera(), RenderType::BAKE);
+                    renderSkybox(scene, cubeMap->GetCamera(), false);
 
+                }
             }
             cubeMap->UnbindBuffer();
+
+            for(int i = 0; i < 6; i++)
+                cubeMap->MarkFaceUpdated(i);
         }
         
 
@@ -239,7 +431,182 @@ namespace GLEP{
         ResetViewport();
     }
 
-    void Renderer::renderShadowMap(std::shared_ptr<Scene> scene){
+    void Renderer::UpdateProbes(std::shared_ptr<Scene> scene, std::shared_ptr<Camera> camera){
+        _probeUpdateStats = ProbeUpdateStats();
+        if(!scene || !camera || ProbeFaceBudget <= 0) return;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        Frustum frustum = Frustum::FromMatrix(camera->GetProjectionMatrix() * camera->GetViewMatrix());
+        glm::vec3 cameraPos = camera->GetWorldPosition();
+        float time = Time::GetElapsedTimeF();
+
+        _probeQueue.clear();
+        for(const std::shared_ptr<BakedCubeMap>& cubeMap : scene->GetBakedCubeMaps()){
+            if(!cubeMap->GetPendingFaces()) continue;
+
+            float distance = glm::distance(cameraPos, cubeMap->GetPosition());
+
+            //Approximate fraction of the view covered by the probe's influence sphere
+            float coverage = 0.0f;
+            if(frustum.IntersectsSphere(cubeMap->GetPosition(), cubeMap->InfluenceRadius)){
+                float ratio = cubeMap->InfluenceRadius / std::max(distance, cubeMap->InfluenceRadius);
+                coverage = ratio * ratio;
+            }
+
+            //Probes that have never been baked always go first
+            float staleness = cubeMap->GetIsBaked() ? time - cubeMap->GetLastUpdateTime() : 1000.0f;
+
+            float priority = coverage + 1.0f / (1.0f + distance) + 0.1f * staleness;
+            _probeQueue.push_back({cubeMap, priority});
+        }
+
+        if(_probeQueue.empty()) return;
+
+        std::sort(_probeQueue.begin(), _probeQueue.end(), [](const ProbeUpdate& a, const ProbeUpdate& b){
+            return a.Priority > b.Priority;
+        });
+
+        bool rebind = false;
+        bool budgetSpent = false;
+        for(const ProbeUpdate& update : _probeQueue){
+            if(budgetSpent){
+                _probeUpdateStats.ProbesPending++;
+                continue;
+            }
+
+            std::shared_ptr<BakedCubeMap> cubeMap = update.CubeMap;
+            SetViewport(0,0,cubeMap->GetFramebuffer()->GetWidth(), cubeMap->GetFramebuffer()->GetHeight());
+
+            int remainingBudget = ProbeFaceBudget - _probeUpdateStats.FacesRendered;
+            if(cubeMap->GetPendingFaces() == BakedCubeMap::ALL_FACES && remainingBudget >= 6 && LayeredBake && cubeMap->BindLayeredBuffer()){
+                renderLayeredCubeMap(scene, cubeMap);
+                for(int i = 0; i < 6; i++)
+                    cubeMap->MarkFaceUpdated(i);
+                _probeUpdateStats.FacesRendered += 6;
+            } else {
+                for(int i = 0; i < 6; i++){
+                    if(!(cubeMap->GetPendingFaces() & (1 << i))) continue;
+
+                    cubeMap->SetDirection(i);
+                    cubeMap->BindBuffer(i);
+
+                    renderSceneObjects(scene, cubeMap->GetCamera(), RenderType::BAKE);
+                    renderSkybox(scene, cubeMap->GetCamera(), false);
+
+                    cubeMap->MarkFaceUpdated(i);
+                    _probeUpdateStats.FacesRendered++;
+
+                    if(_probeUpdateStats.FacesRendered >= ProbeFaceBudget) break;
+                    if(ProbeTimeBudget > 0.0f && std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= ProbeTimeBudget) break;
+                }
+            }
+
+            cubeMap->UnbindBuffer();
+
+            if(!cubeMap->GetPendingFaces()){
+                rebind = true;
+                _probeUpdateStats.ProbesCompleted++;
+
+                if(cubeMap->UpdateMode == ProbeUpdateMode::REALTIME)
+                    cubeMap->RequestUpdate();
+            } else {
+                _probeUpdateStats.ProbesPending++;
+            }
+
+            budgetSpent = _probeUpdateStats.FacesRendered >= ProbeFaceBudget ||
+                (ProbeTimeBudget > 0.0f && std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= ProbeTimeBudget);
+        }
+
+        if(rebind) scene->UpdateBake();
+
+        ResetViewport();
+        _probeUpdateStats.TimeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void Renderer::renderLayeredCubeMap(const std::shared_ptr<Scene>& scene, const std::shared_ptr<BakedCubeMap>& cubeMap){
+        std::shared_ptr<Camera> camera = cubeMap->GetCamera();
+        glm::mat4 projectionMatrix = camera->GetProjectionMatrix();
+
+        glm::mat4 faceViews[6];
+        glm::mat4 faceViewProjections[6];
+        glm::mat4 skyboxViewProjections[6];
+        Frustum faceFrustums[6];
+        for(int i = 0; i < 6; i++){
+            cubeMap->SetDirection(i);
+            faceViews[i] = camera->GetViewMatrix();
+            faceViewProjections[i] = projectionMatrix * faceViews[i];
+            skyboxViewProjections[i] = projectionMatrix * glm::mat4(glm::mat3(faceViews[i]));
+            faceFrustums[i] = Frustum::FromMatrix(faceViewProjections[i]);
+        }
+        glm::vec3 cameraPos = camera->GetWorldPosition();
+
+        glClearColor(ClearColor.r, ClearColor.g, ClearColor.b, ClearColor.a);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        _layeredFallbackDraws.clear();
+
+        for(const std::shared_ptr<Model>& model : scene->GetModels()){
+            glm::mat4 modelMatrix = model->GetModelMatrix();
+            for(const std::shared_ptr<Mesh>& m : model->GetMeshes()){
+                if(m->MaterialData->BakeRequired) continue;
+
+                glm::vec3 center;
+                float radius;
+                Math::BoundsToSphere(m->GeometryData->GetBoundsMin(), m->GeometryData->GetBoundsMax(), modelMatrix, center, radius);
+
+                int faceMask = 0;
+                for(int i = 0; i < 6; i++){
+                    if(faceFrustums[i].IntersectsSphere(center, radius))
+                        faceMask |= 1 << i;
+                }
+                if(!faceMask) continue;
+
+                if(!m->MaterialData->UseLayered()){
+                    _layeredFallbackDraws.push_back({m.get(), modelMatrix, faceMask});
+                    continue;
+                }
+
+                glUniformMatrix4fv(m->MaterialData->GetUniformLocation("uCubeViewProjection"), 6, GL_FALSE, glm::value_ptr(faceViewProjections[0]));
+                m->MaterialData->SetUniform("uCubeFaceMask", faceMask);
+                setMeshUniforms(m->MaterialData, scene, cameraPos, projectionMatrix, faceViews[0], modelMatrix);
+                m->GeometryData->Draw();
+            }
+        }
+
+        bool skyboxFallback = false;
+        if(scene->Skybox){
+            std::shared_ptr<Material> skyboxMat = scene->Skybox->MaterialData;
+            if(skyboxMat->UseLayered()){
+                glDepthFunc(GL_LEQUAL);
+                glUniformMatrix4fv(skyboxMat->GetUniformLocation("uCubeViewProjection"), 6, GL_FALSE, glm::value_ptr(skyboxViewProjections[0]));
+                skyboxMat->SetUniform("uCubeFaceMask", 0x3F);
+                scene->Skybox->GeometryData->Draw();
+                glDepthFunc(GL_LESS);
+            } else {
+                skyboxFallback = true;
+            }
+        }
+
+        if(_layeredFallbackDraws.empty() && !skyboxFallback) return;
+
+        //Materials without a layered variant are drawn face by face into the same cube targets
+        for(int i = 0; i < 6; i++){
+            cubeMap->BindLayeredBuffer(i);
+
+            for(const LayeredDraw& draw : _layeredFallbackDraws){
+                if(!(draw.FaceMask & (1 << i))) continue;
+                renderMesh(draw.MeshData->GeometryData, draw.MeshData->MaterialData, scene, cameraPos, projectionMatrix, faceViews[i], draw.ModelMatrix, RenderType::BAKE);
+            }
+
+            if(skyboxFallback){
+                cubeMap->SetDirection(i);
+                renderSkybox(scene, camera, false);
+            }
+        }
+    }
+
+    void Renderer::renderShadowMap(const std::shared_ptr<Scene>& scene){
         auto dirLight = scene->GetDirectionalLight();        
         if(!dirLight) return;
         _shadowMapCamera->Position = ShadowMapDistance * -dirLight->Direction;
@@ -249,16 +616,215 @@ namespace GLEP{
 
         _lightSpaceMatrix = _shadowMapCamera->GetProjectionMatrix() * _shadowMapCamera->GetViewMatrix();
 
-        SetViewport(0,0,_shadowMapBuffer->GetWidth(),_shadowMapBuffer->GetHeight());
-        _shadowMapBuffer->Bind();
+        ShadowCacheInvalidation invalidation = checkShadowCache(scene, dirLight->Direction);
+        bool hasDynamic = _shadowCacheStats.DynamicCasters > 0;
+
+        int width = _shadowMapBuffer->GetWidth();
+        int height = _shadowMapBuffer->GetHeight();
+        SetViewport(0,0,width,height);
+
+        if(invalidation != ShadowCacheInvalidation::NONE){
+            _staticShadowMapBuffer->Bind();
+            renderShadowCasters(scene, RenderType::SHADOW_MAP_STATIC);
+
+            _cachedLightDirection = dirLight->Direction;
+            _cachedShadowMapDistance = ShadowMapDistance;
+            _cachedShadowProjection = _shadowMapCamera->GetProjectionMatrix();
+            _cachedStaticCasters = _staticCasters;
+            _shadowCacheValid = true;
+            _shadowCacheInvalidated = false;
+
+            _shadowCacheStats.LastInvalidation = invalidation;
+            _shadowCacheStats.FramesReused = 0;
+            _shadowCacheStats.StaticRenders++;
+        } else {
+            _shadowCacheStats.FramesReused++;
+        }
 
-        renderSceneObjects(scene, _shadowMapCamera, RenderType::SHADOW_MAP);
+        //The result only needs refreshing if the static layer changed or dynamic casters are (or were) drawn on top of it
+        if(invalidation != ShadowCacheInvalidation::NONE || hasDynamic || _shadowMapHasDynamic){
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, _staticShadowMapBuffer->GetBufferID());
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _shadowMapBuffer->GetBufferID());
+            glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+            if(hasDynamic){
+                _shadowMapBuffer->Bind();
+                renderShadowCasters(scene, RenderType::SHADOW_MAP_DYNAMIC);
+            }
+        }
+        _shadowMapHasDynamic = hasDynamic;
 
         _shadowMapBuffer->Unbind();
         ResetViewport();
 
     }
 
+    void Renderer::renderShadowCasters(const std::shared_ptr<Scene>& scene, RenderType type){
+        //Dynamic casters are drawn on top of the copied static shadow layer
+        if(type == RenderType::SHADOW_MAP_STATIC)
+            glClear(GL_DEPTH_BUFFER_BIT);
+
+        _depthCasters.clear();
+        _alphaCasters.clear();
+        _materialCasters.clear();
+
+        for(const std::shared_ptr<Model>& model : scene->GetModels()){
+            if(model->IsStatic != (type == RenderType::SHADOW_MAP_STATIC))
+                continue;
+
+            glm::mat4 modelMatrix = model->GetModelMatrix();
+            for(const std::shared_ptr<Mesh>& m : model->GetMeshes()){
+                if(!m->MaterialData->CastShadows) 
+                    continue;
+
+                switch(m->MaterialData->ShadowCaster){
+                    case ShadowCasterMode::DEPTH_ONLY:
+                        _depthCasters.push_back({m.get(), modelMatrix});
+                        break;
+
+                    case ShadowCasterMode::ALPHA_TESTED:
+                        if(m->MaterialData->GetDiffuseTexture())
+                            _alphaCasters.push_back({m.get(), modelMatrix});
+                        else
+                            _depthCasters.push_back({m.get(), modelMatrix});
+                        break;
+
+                    case ShadowCasterMode::MATERIAL:
+                        _materialCasters.push_back({m.get(), modelMatrix});
+                        break;
+                }
+            }
+        }
+
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+        if(!_depthCasters.empty()){
+            _shadowCasterShader->Use();
+            glUniformMatrix4fv(_shadowCasterLightSpaceLoc, 1, GL_FALSE, glm::value_ptr(_lightSpaceMatrix));
+
+            for(const MeshDraw& caster : _depthCasters){
+                drawDepthOnly(caster, _shadowCasterModelLoc, GL_BACK);
+            }
+        }
+
+        if(!_alphaCasters.empty()){
+            _shadowCasterAlphaShader->Use();
+            glUniformMatrix4fv(_shadowCasterAlphaLightSpaceLoc, 1, GL_FALSE, glm::value_ptr(_lightSpaceMatrix));
+            glUniform1i(_shadowCasterAlphaTexLoc, (int)TextureType::DIFFUSE);
+
+            for(const MeshDraw& caster : _alphaCasters){
+                caster.MeshData->MaterialData->GetDiffuseTexture()->Bind();
+                drawDepthOnly(caster, _shadowCasterAlphaModelLoc, GL_BACK);
+            }
+        }
+
+        if(!_materialCasters.empty()){
+            glm::mat4 projectionMatrix = _shadowMapCamera->GetProjectionMatrix();
+            glm::mat4 viewMatrix = _shadowMapCamera->GetViewMatrix();
+            glm::vec3 cameraPos = _shadowMapCamera->GetWorldPosition();
+
+            for(const MeshDraw& caster : _materialCasters){
+                renderMesh(caster.MeshData->GeometryData, caster.MeshData->MaterialData, scene, cameraPos, projectionMatrix, viewMatrix, caster.ModelMatrix, type);
+            }
+        }
+
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    }
+
+    void Renderer::drawDepthOnly(const MeshDraw& draw, GLint modelLoc, GLenum cullFace){
+        if(draw.MeshData->MaterialData->CullFace == MaterialCull::NONE){
+            glDisable(GL_CULL_FACE);
+        } else {
+            glEnable(GL_CULL_FACE);
+            glCullFace(cullFace);
+        }
+
+        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(draw.ModelMatrix));
+        draw.MeshData->GeometryData->Draw();
+    }
+
+    ShadowCacheInvalidation Renderer::checkShadowCache(const std::shared_ptr<Scene>& scene, glm::vec3 lightDirection){
+        _staticCasters.clear();
+        int dynamicCasters = 0;
+
+        for(const std::shared_ptr<Model>& model : scene->GetModels()){
+            bool castsShadows = false;
+            for(const std::shared_ptr<Mesh>& m : model->GetMeshes()){
+                if(m->MaterialData->CastShadows){
+                    castsShadows = true;
+                    break;
+                }
+            }
+
+            if(!castsShadows) continue;
+
+            if(model->IsStatic)
+                _staticCasters.push_back({model.get(), model->GetModelMatrix()});
+            else
+                dynamicCasters++;
+        }
+
+        _shadowCacheStats.StaticCasters = (int)_staticCasters.size();
+        _shadowCacheStats.DynamicCasters = dynamicCasters;
+
+        if(!_shadowCacheValid) 
+            return ShadowCacheInvalidation::INITIAL;
+
+        if(_shadowCacheInvalidated) 
+            return ShadowCacheInvalidation::MANUAL;
+
+        if(lightDirection != _cachedLightDirection) 
+            return ShadowCacheInvalidation::LIGHT_DIRECTION;
+
+        if(ShadowMapDistance != _cachedShadowMapDistance) 
+            return ShadowCacheInvalidation::SHADOW_MAP_DISTANCE;
+
+        if(_shadowMapCamera->GetProjectionMatrix() != _cachedShadowProjection) 
+            return ShadowCacheInvalidation::SHADOW_MAP_CAMERA;
+
+        if(_staticCasters != _cachedStaticCasters) 
+            return ShadowCacheInvalidation::STATIC_SET;
+
+        return ShadowCacheInvalidation::NONE;
+    }
+
+    void Renderer::updateRenderScale(){
+        int index = _frameTimeQueryFrame % 3;
+        if(_frameTimeQueriesIssued[index]){
+            //Results are read three frames late so the query never stalls the pipeline
+            GLuint available = 0;
+            glGetQueryObjectuiv(_frameTimeQueries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+            if(available){
+                GLuint64 elapsed = 0;
+                glGetQueryObjectui64v(_frameTimeQueries[index], GL_QUERY_RESULT, &elapsed);
+
+                float timeMs = (float)elapsed / 1000000.0f;
+                _renderScaleStats.GpuTimeMs = _renderScaleStats.GpuTimeMs > 0.0f ? glm::mix(_renderScaleStats.GpuTimeMs, timeMs, 0.1f) : timeMs;
+            }
+        }
+
+        _framesSinceScaleChange++;
+
+        //The scale only steps once the smoothed time leaves the band around the target, and the smoothed time has had time to settle since the last step
+        if(DynamicResolution && _renderScaleStats.GpuTimeMs > 0.0f && _framesSinceScaleChange >= RenderScaleCooldown){
+            float scale = RenderScale;
+            if(_renderScaleStats.GpuTimeMs > TargetFrameTime * (1.0f + FrameTimeHysteresis))
+                scale -= RenderScaleStep;
+            else if(_renderScaleStats.GpuTimeMs < TargetFrameTime * (1.0f - FrameTimeHysteresis))
+                scale += RenderScaleStep;
+
+            scale = glm::clamp(scale, MinRenderScale, MaxRenderScale);
+            if(scale != RenderScale){
+                RenderScale = scale;
+                _framesSinceScaleChange = 0;
+                _renderScaleStats.ScaleChanges++;
+            }
+        }
+
+        _renderScaleStats.Scale = RenderScale;
+    }
+
     void Renderer::updateResolution(const std::shared_ptr<BufferPassComposer>& passComposer){
         if(!TargetWindow) return;
 
@@ -269,33 +835,116 @@ namespace GLEP{
             TargetCamera->SetAspectRatio(resolution.x / resolution.y);
         }
 
-        if(passComposer && passComposer->GetResolution() != resolution){
-            passComposer->SetResolution(resolution);
+        //A live drag-resize changes the window size every frame, so the composer only follows once the size has settled
+        if(resolution != _pendingResolution){
+            _pendingResolution = resolution;
+            _resolutionStableFrames = 0;
+        } else if(_resolutionStableFrames < ResizeDebounceFrames){
+            _resolutionStableFrames++;
+        }
+
+        if(_settledResolution.x <= 0.0f || _resolutionStableFrames >= ResizeDebounceFrames)
+            _settledResolution = _pendingResolution;
+
+        //The scene renders into the composer at the render scale, its final pass upsamples to the window
+        glm::vec2 renderResolution = glm::max(glm::round(_settledResolution * glm::max(RenderScale, 0.01f)), glm::vec2(1.0f));
+        _renderScaleStats.RenderResolution = passComposer ? renderResolution : resolution;
+
+        if(passComposer && passComposer->GetResolution() != renderResolution){
+            passComposer->SetResolution(renderResolution);
         }
 
     }
     
+    void Renderer::updateFrameGraph(const std::shared_ptr<BufferPassComposer>& passComposer, const std::shared_ptr<Framebuffer>& buffer){
+        unsigned int revision = passComposer ? passComposer->GetRevision() : 0;
+        bool fusePasses = passComposer && passComposer->FusePasses;
+        FramebufferColor colorFormat = passComposer ? passComposer->ColorFormat : FramebufferColor::RGB8;
+        int samples = passComposer ? passComposer->Samples : 0;
+        glm::vec2 outputResolution = !buffer && TargetWindow ? TargetWindow->GetResolution() : glm::vec2(0.0f);
+        if(_frameGraphKey.Built && _frameGraphKey.Composer == passComposer && _frameGraphKey.ComposerRevision == revision
+            && _frameGraphKey.FusePasses == fusePasses && _frameGraphKey.ColorFormat == colorFormat && _frameGraphKey.Samples == samples
+            && _frameGraphKey.Output == buffer && _frameGraphKey.OutputResolution == outputResolution
+            && _frameGraphKey.Shadows == RenderShadows)
+            return;
+
+        _frameGraphKey.Composer = passComposer;
+        _frameGraphKey.ComposerRevision = revision;
+        _frameGraphKey.FusePasses = fusePasses;
+        _frameGraphKey.ColorFormat = colorFormat;
+        _frameGraphKey.Samples = samples;
+        _frameGraphKey.Output = buffer;
+        _frameGraphKey.OutputResolution = outputResolution;
+        _frameGraphKey.Shadows = RenderShadows;
+        _frameGraphKey.Built = true;
+
+        _frameGraph.Clear();
+        RenderGraphResource output = _frameGraph.ImportTarget("output", buffer, outputResolution);
+
+        std::vector<RenderGraphResource> objectReads;
+        if(RenderShadows){
+            RenderGraphResource shadowMap = _frameGraph.ImportTarget("shadow_map", _shadowMapBuffer);
+            _frameGraph.AddPass("shadow_map", {}, shadowMap, [this](RenderGraph& g){ renderShadowMap(_frameScene); });
+            objectReads.push_back(shadowMap);
+        }
+
+        //Without a composer the scene is drawn straight to the output
+        RenderGraphResource objects = output;
+        RenderGraphResource skybox = output;
+        if(passComposer){
+            //Scene depth is only kept in a texture when a pass samples it
+            FramebufferDesc sceneDesc;
+            sceneDesc.Color = colorFormat;
+            sceneDesc.Depth = passComposer->GetReadsDepth() ? FramebufferDepth::TEXTURE : FramebufferDepth::RENDERBUFFER;
+            sceneDesc.Samples = samples;
+
+            FramebufferDesc skyboxDesc = sceneDesc;
+            skyboxDesc.Depth = FramebufferDepth::RENDERBUFFER;
+
+            objects = _frameGraph.CreateTarget("objects", passComposer->GetResolution(), sceneDesc);
+            skybox = passComposer->GetFogPass() ? _frameGraph.CreateTarget("skybox", passComposer->GetResolution(), skyboxDesc) : objects;
+        }
+
+        _frameGraph.AddPass("objects", objectReads, objects, [this](RenderGraph& g){
+            renderSceneObjects(_frameScene, TargetCamera);
+        });
+
+        //Fog is composited over a separately rendered skybox
+        bool separateSkybox = skybox != objects;
+        _frameGraph.AddPass("skybox", separateSkybox ? std::vector<RenderGraphResource>() : std::vector<RenderGraphResource>{objects}, skybox, [this, separateSkybox](RenderGraph& g){
+            if(separateSkybox){
+                glClearColor(ClearColor.r, ClearColor.g, ClearColor.b, ClearColor.a);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            }
+            renderSkybox(_frameScene, TargetCamera, separateSkybox);
+        });
+
+        if(passComposer)
+            passComposer->AddPasses(_frameGraph, objects, skybox, output);
+
+        _frameGraph.Compile();
+    }
 
     void Renderer::Render(std::shared_ptr<Scene> scene, std::shared_ptr<Framebuffer> buffer){
         if((!buffer && !TargetWindow)|| !scene || !TargetCamera) return;
 
+        AllocationStats allocationStart = AllocationTracker::GetThreadStats();
+
         TargetCamera->UpdateTransformVectors();
+        if(scene->Partition)
+            scene->Partition->Update(*scene, TargetCamera->GetWorldPosition());
         scene->UpdateObjects();
 
-        if(buffer) buffer->Bind();
-
-        if(RenderShadows) renderShadowMap(scene);
+        UpdateProbes(scene, TargetCamera);
+        scene->UpdateBake();
 
         std::shared_ptr<BufferPassComposer> passComposer = scene->PassComposer;
 
+        updateRenderScale();
+
         //TODO: Don't update every frame
         updateResolution(passComposer);
-
-        bool depthTestSkybox = false;
-        if(passComposer) {
-            passComposer->NewFrame();
-            depthTestSkybox = passComposer->GetFogPass() != nullptr;
-        }
+        updateFrameGraph(passComposer, buffer);
 
         if(GuiRenderFunc){
             ImGui_ImplOpenGL3_NewFrame();
@@ -303,16 +952,32 @@ namespace GLEP{
             ImGui::NewFrame();
         }
 
+        int queryIndex = _frameTimeQueryFrame % 3;
+        glBeginQuery(GL_TIME_ELAPSED, _frameTimeQueries[queryIndex]);
 
-        renderSceneObjects(scene, TargetCamera);
-        if(passComposer)
-            passComposer->PreSkybox();
-        renderSkybox(scene, TargetCamera, depthTestSkybox);
+        _frameScene = scene;
+        _frameGraph.Execute();
+        _frameScene = nullptr;
 
-        if(passComposer) passComposer->Render();
+        glEndQuery(GL_TIME_ELAPSED);
+        _frameTimeQueriesIssued[queryIndex] = true;
+        _frameTimeQueryFrame++;
 
         if(buffer) buffer->Unbind();
 
+        if(Capture){
+            if(buffer) Capture->Capture(buffer);
+            else Capture->Capture(TargetWindow);
+        }
+
+        AllocationStats allocationEnd = AllocationTracker::GetThreadStats();
+        _frameAllocationStats.Allocations = allocationEnd.Allocations - allocationStart.Allocations;
+        _frameAllocationStats.Bytes = allocationEnd.Bytes - allocationStart.Bytes;
+
+        if(ReportFrameAllocations && _frameAllocationStats.Allocations > 0){
+            Print(PrintCode::ERROR, "RENDERER", "Frame made " + std::to_string(_frameAllocationStats.Allocations) + " heap allocations (" + std::to_string(_frameAllocationStats.Bytes) + " bytes)");
+        }
+
         if(GuiRenderFunc){
             GuiRenderFunc();
             ImGui::Render();
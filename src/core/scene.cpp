@@ -17,11 +17,27 @@
 
 #include <GLEP/core/scene.hpp>
 
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <limits>
+
 namespace GLEP {
 
+    unsigned int Scene::LoadThreads = 0;
+
     Scene::Scene(){}
 
-    Scene::~Scene(){}
+    Scene::~Scene(){
+        //Objects can outlive the scene, don't leave them pointing at it
+        for(std::shared_ptr<SceneObject>& o : _objects){
+            _transforms.Detach(o.get());
+            _componentStore.Detach(o.get());
+            if(o->_scene == this) o->_scene = nullptr;
+        }
+    }
 
     SceneLightData Scene::GetLightData(){ return _lightData; }
 
@@ -30,6 +46,13 @@ namespace GLEP {
     }
 
     void Scene::Remove(std::shared_ptr<SceneObject> object){
+        _bvh.Remove(object.get());
+        _transforms.Invalidate();
+        _transforms.Detach(object.get());
+        _componentStore.Detach(object.get());
+        _probeAssignments.erase(object.get());
+        unindexObject(object.get());
+        if(object->_scene == this) object->_scene = nullptr;
         _objects.erase(std::remove(_objects.begin(), _objects.end(), object), _objects.end());
     }
 
@@ -52,6 +75,16 @@ namespace GLEP {
                 break;
         }
         _lights.erase(std::remove(_lights.begin(), _lights.end(), light), _lights.end());
+
+        std::vector<std::shared_ptr<Light>>& typed = _lightsByType[(int)light->GetType()];
+        typed.erase(std::remove(typed.begin(), typed.end(), light), typed.end());
+
+        if(light == _directionalLight){
+            _directionalLight = nullptr;
+            for(std::shared_ptr<Light>& l : _lightsByType[(int)LightType::DIRECTION]){
+                if((_directionalLight = std::dynamic_pointer_cast<DirectionalLight>(l))) break;
+            }
+        }
     }
 
     void Scene::Add(std::shared_ptr<BakedCubeMap> cubeMap){
@@ -60,6 +93,12 @@ namespace GLEP {
 
     void Scene::Add(std::shared_ptr<SceneObject> object){
         _objects.push_back(object);
+        _bvh.Insert(object.get());
+        _transforms.Invalidate();
+        _transforms.Attach(object.get());
+        _componentStore.Attach(object.get());
+        indexObject(object);
+        object->_scene = this;
     }
 
     void Scene::Add(std::shared_ptr<Light> light){
@@ -82,49 +121,159 @@ namespace GLEP {
         }
 
         _lights.push_back(light);
+        _lightsByType[(int)light->GetType()].push_back(light);
+
+        if(!_directionalLight && light->GetType() == LightType::DIRECTION)
+            _directionalLight = std::dynamic_pointer_cast<DirectionalLight>(light);
+    }
+
+    void Scene::indexObject(const std::shared_ptr<SceneObject>& object){
+        _nameIndex[object->_name].push_back(object);
+        _tagIndex[object->_tag].push_back(object);
+
+        if(std::shared_ptr<Model> model = std::dynamic_pointer_cast<Model>(object))
+            _models.push_back(model);
+
+        if(!object->GetComponents().empty())
+            _componentObjects.push_back(object);
+    }
+
+    void Scene::unindexObject(SceneObject* object){
+        if(object->_scene != this) return;
+
+        removeFromIndex(_nameIndex, object->_name, object);
+        removeFromIndex(_tagIndex, object->_tag, object);
+
+        _models.erase(std::remove_if(_models.begin(), _models.end(), [object](const std::shared_ptr<Model>& m){ return m.get() == object; }), _models.end());
+        _componentObjects.erase(std::remove_if(_componentObjects.begin(), _componentObjects.end(), [object](const std::shared_ptr<SceneObject>& o){ return o.get() == object; }), _componentObjects.end());
+    }
+
+    void Scene::removeFromIndex(std::unordered_map<std::string, std::vector<std::shared_ptr<SceneObject>>>& index, const std::string& key, SceneObject* object){
+        auto bucket = index.find(key);
+        if(bucket == index.end()) return;
+
+        std::vector<std::shared_ptr<SceneObject>>& objects = bucket->second;
+        objects.erase(std::remove_if(objects.begin(), objects.end(), [object](const std::shared_ptr<SceneObject>& o){ return o.get() == object; }), objects.end());
+        if(objects.empty()) index.erase(bucket);
+    }
+
+    void Scene::Reindex(const std::shared_ptr<SceneObject>& object, const std::string& oldName, const std::string& oldTag){
+        if(object->_name != oldName){
+            removeFromIndex(_nameIndex, oldName, object.get());
+            _nameIndex[object->_name].push_back(object);
+        }
+
+        if(object->_tag != oldTag){
+            removeFromIndex(_tagIndex, oldTag, object.get());
+            _tagIndex[object->_tag].push_back(object);
+        }
+    }
+
+    void Scene::AddComponentObject(const std::shared_ptr<SceneObject>& object){
+        _componentObjects.push_back(object);
     }
 
     void Scene::UpdateObjects(){
-        for(std::shared_ptr<SceneObject> o : _objects){
+        //Transforms of objects without components are handled by the hierarchy pass below
+        for(std::shared_ptr<SceneObject>& o : _componentObjects){
             o->Update();
         }
-    }
 
-    std::shared_ptr<CubeMap> Scene::findClosestCubeMap(glm::vec3 position){
-        if(_bakedCubeMaps.empty()) return nullptr;
+        _componentStore.Update();
 
-        std::shared_ptr<BakedCubeMap> closest = _bakedCubeMaps[0];
-        float closestDist = glm::distance(position, closest->GetPosition());
+        _transforms.Update(_objects);
 
-        for(int i = 1; i < _bakedCubeMaps.size(); i++){
-            float dist = glm::distance(position, _bakedCubeMaps[i]->GetPosition());
-        
-            if(dist < closestDist){
-                closest = _bakedCubeMaps[i];
-                closestDist = dist;
-            }
-        }
+        _bvh.Refit();
+    }
+
+    SceneBVH& Scene::GetBVH(){
+        return _bvh;
+    }
 
-        return std::dynamic_pointer_cast<CubeMap>(closest);
+    ComponentStore& Scene::GetComponentStore(){
+        return _componentStore;
+    }
+
+    void Scene::RebuildBVH(){
+        _bvh.Build(_objects);
     }
 
     void Scene::UpdateBake(){
         if(_bakedCubeMaps.empty()) return;
 
-        for(std::shared_ptr<SceneObject> o : _objects){
-            std::shared_ptr<Model> model = std::dynamic_pointer_cast<Model>(o);
-            if(!model) continue;
+        bool probesChanged = _probeGrid.IsOutdated(_bakedCubeMaps);
+        if(probesChanged) _probeGrid.Build(_bakedCubeMaps);
 
-            for(std::shared_ptr<Mesh> mesh : model->GetMeshes()){
-                std::shared_ptr<Material> material = mesh->MaterialData;
-                if(material->BakeRequired){
-                    auto closest = findClosestCubeMap(model->GetWorldPosition());
-                    material->SetUniformValue<std::shared_ptr<CubeMap>>("uMaterial.cubeMap", closest);
-                }
+        //Toggling blending changes every object's second probe and weight
+        if(BlendProbes != _assignedBlendProbes){
+            _assignedBlendProbes = BlendProbes;
+            _probeAssignments.clear();
+        }
+
+        for(const std::shared_ptr<Model>& model : _models){
+            glm::vec3 position = model->GetWorldPosition();
+            auto it = _probeAssignments.find(model.get());
+            if(!probesChanged && it != _probeAssignments.end() && it->second.Position == position && !materialsChanged(model.get(), it->second))
+                continue;
+
+            ProbeAssignment& assignment = _probeAssignments[model.get()];
+            assignment.Position = position;
+            assignProbe(model, assignment);
+        }
+    }
+
+    bool Scene::materialsChanged(Model* model, const ProbeAssignment& assignment){
+        const std::vector<std::shared_ptr<Mesh>>& meshes = model->GetMeshes();
+        if(meshes.size() != assignment.Materials.size()) return true;
+
+        for(size_t i = 0; i < meshes.size(); i++){
+            if(meshes[i]->MaterialData.get() != assignment.Materials[i]) return true;
+        }
+        return false;
+    }
+
+    void Scene::assignProbe(std::shared_ptr<Model> model, ProbeAssignment& assignment){
+        //Remember the materials the uniforms went to, a swapped material needs them applied again
+        assignment.Materials.clear();
+        for(const std::shared_ptr<Mesh>& mesh : model->GetMeshes()){
+            assignment.Materials.push_back(mesh->MaterialData.get());
+        }
+
+        float nearestDistance, secondDistance;
+        assignment.Primary = _probeGrid.FindNearest(assignment.Position, assignment.Secondary, nearestDistance, secondDistance);
+        if(assignment.Primary < 0) return;
+
+        //Weight towards the second probe as the object approaches the midpoint between both
+        if(BlendProbes && assignment.Secondary >= 0 && nearestDistance + secondDistance > 0.0f){
+            assignment.Blend = nearestDistance / (nearestDistance + secondDistance);
+        } else {
+            assignment.Secondary = assignment.Primary;
+            assignment.Blend = 0.0f;
+        }
+
+        std::shared_ptr<CubeMap> primary = _bakedCubeMaps[assignment.Primary];
+        std::shared_ptr<CubeMap> secondary = _bakedCubeMaps[assignment.Secondary];
+
+        for(const std::shared_ptr<Mesh>& mesh : model->GetMeshes()){
+            std::shared_ptr<Material> material = mesh->MaterialData;
+            if(material->BakeRequired){
+                material->SetUniformValue<std::shared_ptr<CubeMap>>("uMaterial.cubeMap", primary);
+                material->SetUniformValue<std::shared_ptr<CubeMap>>("uMaterial.blendCubeMap", secondary);
+                material->SetUniformValue<float>("uMaterial.blend", assignment.Blend);
             }
         }
     }
 
+    void Scene::InvalidateProbeAssignments(){
+        _probeAssignments.clear();
+    }
+
+    const ProbeAssignment* Scene::GetProbeAssignment(SceneObject* object){
+        auto it = _probeAssignments.find(object);
+        if(it == _probeAssignments.end()) return nullptr;
+        return &it->second;
+    }
+
     std::vector<std::shared_ptr<SceneObject>>& Scene::GetObjects(){
         return _objects;
     }
@@ -152,32 +301,72 @@ namespace GLEP {
         return _bakedCubeMaps[index];
     }
 
-    std::shared_ptr<DirectionalLight> Scene::GetDirectionalLight(){
-        for(std::shared_ptr<Light> l : _lights){
-            if(auto dirLight = std::dynamic_pointer_cast<DirectionalLight>(l)){
-                return dirLight;
-            }
-        }
+    const std::vector<std::shared_ptr<Model>>& Scene::GetModels(){
+        return _models;
+    }
 
-        return nullptr;
+    const std::vector<std::shared_ptr<SceneObject>>& Scene::GetObjectsWithComponents(){
+        return _componentObjects;
     }
 
-    std::shared_ptr<SceneObject> Scene::FindObjectByName(std::string name){
-        for(std::shared_ptr<SceneObject> o : _objects){
-            if(o->Name == name) return o;
-        }
+    const std::vector<std::shared_ptr<Light>>& Scene::GetLightsByType(LightType type){
+        return _lightsByType[(int)type];
+    }
+
+    const std::shared_ptr<DirectionalLight>& Scene::GetDirectionalLight(){
+        return _directionalLight;
+    }
 
-        return nullptr;
+    std::shared_ptr<SceneObject> Scene::FindObjectByName(std::string name){
+        auto it = _nameIndex.find(name);
+        if(it == _nameIndex.end()) return nullptr;
+        return it->second.front();
     }
 
     std::vector<std::shared_ptr<SceneObject>> Scene::FindObjectsByName(std::string name){
-        std::vector<std::shared_ptr<SceneObject>> result;
+        auto it = _nameIndex.find(name);
+        if(it == _nameIndex.end()) return {};
+        return it->second;
+    }
+
+    std::shared_ptr<SceneObject> Scene::FindObjectByTag(std::string tag){
+        auto it = _tagIndex.find(tag);
+        if(it == _tagIndex.end()) return nullptr;
+        return it->second.front();
+    }
+
+    std::vector<std::shared_ptr<SceneObject>> Scene::FindObjectsByTag(std::string tag){
+        auto it = _tagIndex.find(tag);
+        if(it == _tagIndex.end()) return {};
+        return it->second;
+    }
 
-        for(std::shared_ptr<SceneObject> o : _objects){
-            if(o->Name == name) result.push_back(o);
+    void Scene::WriteJson(std::ostream& stream, unsigned int indent){
+        JsonStreamWriter writer(stream, indent);
+        writer.BeginObject();
+
+        writer.BeginArray("objects");
+        for(auto& o : _objects){
+            writer.Value(o->ToJson());
         }
+        writer.EndArray();
 
-        return result;
+        writer.BeginArray("lights");
+        for(auto& l : _lights){
+            writer.Value(l->ToJson());
+        }
+        writer.EndArray();
+
+        writer.BeginArray("baked_cube_maps");
+        for(auto& b : _bakedCubeMaps){
+            writer.Value(b->ToJson());
+        }
+        writer.EndArray();
+
+        writer.Value("pass_composer", PassComposer ? PassComposer->ToJson() : json());
+        writer.Value("skybox", Skybox ? Skybox->ToJson() : json());
+
+        writer.EndObject();
     }
 
     json Scene::ToJson(){
@@ -211,30 +400,94 @@ namespace GLEP {
         return j;
     }
 
+    std::shared_ptr<SceneObject> Scene::ObjectFromJson(const json& data){
+        if(data["type"] == "model" || data["type"] == "import_model" || data["type"] == "import_geometry_model"){
+            std::shared_ptr<Model> model = Model::FromJson(data);
+            SceneObject::ApplyFromJson(model, data["object_data"]);
+            return model;
+        }
+
+        return SceneObject::FromJson(data);
+    }
+
+    unsigned int Scene::loadThreadCount(int objectCount){
+        unsigned int threadCount = LoadThreads ? LoadThreads : std::max(1u, std::thread::hardware_concurrency());
+        return std::min(threadCount, (unsigned int)std::max(objectCount, 1));
+    }
+
+    void Scene::addObjects(Scene& scene, const std::vector<const json*>& objectsData){
+        int objectCount = (int)objectsData.size();
+        unsigned int threadCount = loadThreadCount(objectCount);
+
+        if(threadCount <= 1){
+            for(int i = 0; i < objectCount; i++){
+                scene.Add(ObjectFromJson(*objectsData[i]));
+            }
+            return;
+        }
+
+        //Parse, import and decode on workers, recording GL work per object
+        std::vector<std::shared_ptr<SceneObject>> objects(objectCount);
+        std::vector<DeferredGLTaskList> glTasks(objectCount);
+        std::atomic<int> next(0);
+        std::mutex errorMutex;
+        std::exception_ptr error;
+
+        //The blob source is per thread, workers resolve blobs against the caller's
+        const std::vector<GeometryBlob>* blobs = Geometry::GetBlobSource();
+
+        auto worker = [&](){
+            GeometryBlobScope blobScope(blobs);
+            for(int i = next++; i < objectCount; i = next++){
+                DeferredGL::Begin(&glTasks[i]);
+                try {
+                    objects[i] = ObjectFromJson(*objectsData[i]);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if(!error) error = std::current_exception();
+                }
+                DeferredGL::End();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for(unsigned int t = 1; t < threadCount; t++){
+            workers.emplace_back(worker);
+        }
+        worker();
+        for(std::thread& t : workers){
+            t.join();
+        }
+
+        if(error) std::rethrow_exception(error);
+
+        //Create GL objects on this thread in the same order as a sequential load
+        for(int i = 0; i < objectCount; i++){
+            DeferredGL::Execute(glTasks[i]);
+            scene.Add(objects[i]);
+        }
+    }
+
     std::shared_ptr<Scene> Scene::FromJson(const json& data){
         std::shared_ptr<Scene> result = std::make_shared<Scene>();
 
-        json objectsData = data["objects"];
-        json lightsData = data["lights"];
-        json bakedCubeMapsData = data["baked_cube_maps"];
-        json passComposerData = data["pass_composer"];
-        json skyboxData = data["skybox"];
+        const json& objectsData = data["objects"];
+        const json& lightsData = data["lights"];
+        const json& bakedCubeMapsData = data["baked_cube_maps"];
+        const json& passComposerData = data["pass_composer"];
+        const json& skyboxData = data["skybox"];
 
         if(!objectsData.is_array() || !lightsData.is_array() || !bakedCubeMapsData.is_array()){
             Print(PrintCode::ERROR, "SCENE", "objects, lights, and baked_cube_maps must all be arrays");
             return nullptr;
         }
 
-        for(int i = 0; i < objectsData.size(); i++){
-            json object = objectsData[i];
-            if(object["type"] == "model" || object["type"] == "import_model" || object["type"] == "import_geometry_model"){
-                std::shared_ptr<Model> model = Model::FromJson(object);
-                SceneObject::ApplyFromJson(model, object["object_data"]);
-                result->Add(model);
-            } else {
-                result->Add(SceneObject::FromJson(object));
-            }
+        std::vector<const json*> objects;
+        objects.reserve(objectsData.size());
+        for(const json& o : objectsData){
+            objects.push_back(&o);
         }
+        addObjects(*result, objects);
 
         for(int i = 0; i < lightsData.size(); i++){
             result->Add(Light::FromJson(lightsData[i]));
@@ -250,21 +503,111 @@ namespace GLEP {
         if(!skyboxData.is_null())
             result->Skybox = Mesh::FromJson(skyboxData);
 
+        result->RebuildBVH();
+
+        return result;
+    }
+
+    std::shared_ptr<Scene> Scene::FromJsonStream(std::istream& stream, SceneLoadStats* stats){
+        std::shared_ptr<Scene> result = std::make_shared<Scene>();
+
+        auto start = std::chrono::steady_clock::now();
+        double buildTimeMs = 0.0;
+
+        //Only a batch of parsed objects is held at once, one per load thread
+        std::vector<json> batch;
+        size_t batchSize = loadThreadCount(std::numeric_limits<int>::max());
+
+        auto flush = [&](){
+            if(batch.empty()) return;
+
+            std::vector<const json*> objects;
+            for(const json& o : batch){
+                objects.push_back(&o);
+            }
+            addObjects(*result, objects);
+            batch.clear();
+        };
+
+        auto build = [&](const std::string& key, json& value){
+            auto buildStart = std::chrono::steady_clock::now();
+
+            if(key == "objects"){
+                batch.push_back(std::move(value));
+                if(batch.size() >= batchSize) flush();
+            } else {
+                flush();
+                if(key == "lights"){
+                    result->Add(Light::FromJson(value));
+                } else if(key == "baked_cube_maps"){
+                    result->Add(BakedCubeMap::FromJson(value));
+                } else if(key == "pass_composer"){
+                    if(!value.is_null())
+                        result->PassComposer = BufferPassComposer::FromJson(value);
+                } else if(key == "skybox"){
+                    if(!value.is_null())
+                        result->Skybox = Mesh::FromJson(value);
+                }
+            }
+
+            buildTimeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+        };
+
+        JsonStreamReader reader(
+            [&](const std::string& key, json& value){
+                build(key, value);
+                return true;
+            },
+            [&](const std::string& key, json& value){
+                if(key == "objects" || key == "lights" || key == "baked_cube_maps"){
+                    Print(PrintCode::ERROR, "SCENE", "objects, lights, and baked_cube_maps must all be arrays");
+                    return false;
+                }
+                build(key, value);
+                return true;
+            }
+        );
+
+        if(!reader.Parse(stream))
+            return nullptr;
+
+        auto buildStart = std::chrono::steady_clock::now();
+        flush();
+        result->RebuildBVH();
+        auto end = std::chrono::steady_clock::now();
+        buildTimeMs += std::chrono::duration<double, std::milli>(end - buildStart).count();
+
+        if(stats){
+            stats->ReadTimeMs = std::chrono::duration<double, std::milli>(end - start).count() - buildTimeMs;
+            stats->BuildTimeMs = buildTimeMs;
+            stats->PeakResidentBytes = AllocationTracker::GetPeakResidentBytes();
+        }
+
         return result;
     }
 
-    std::shared_ptr<Scene> Scene::ImportFromFile(std::filesystem::path filePath){
-        if(!std::filesystem::exists(filePath) || filePath.extension() != ".json"){
+    std::shared_ptr<Scene> Scene::ImportFromFile(std::filesystem::path filePath, SceneLoadStats* stats){
+        bool binary = filePath.extension() == SceneBinary::EXTENSION;
+
+        if(!std::filesystem::exists(filePath) || (!binary && filePath.extension() != ".json")){
             Print(PrintCode::ERROR, "SCENE", "Invalid file path to import: " + filePath.string());
             return nullptr;
         }
 
         Print(PrintCode::INFO, "SCENE", "Importing scene from file...");
 
-        std::ifstream f(filePath);
-        json j = json::parse(f);
+        std::shared_ptr<Scene> result;
+        if(binary){
+            result = SceneBinary::Load(filePath, stats);
+        } else {
+            std::ifstream f(filePath);
+            result = FromJsonStream(f, stats);
 
-        std::shared_ptr<Scene> result = FromJson(j);
+            if(stats){
+                stats->Format = "json";
+                stats->FileBytes = std::filesystem::file_size(filePath);
+            }
+        }
 
         if(!result){
             Print(PrintCode::ERROR, "SCENE", "Failed to import scene from file at: " + filePath.string());
@@ -0,0 +1,264 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <GLEP/core/scene_binary.hpp>
+#include <GLEP/core/scene.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace GLEP {
+
+    const std::string SceneBinary::EXTENSION = ".glepb";
+
+    static const char MAGIC[4] = {'G', 'L', 'E', 'P'};
+
+    void SceneBinary::extractBlobs(json& data, std::ofstream& out, std::vector<BlobEntry>& entries){
+        if(data.is_array()){
+            for(json& element : data) extractBlobs(element, out, entries);
+            return;
+        }
+
+        if(!data.is_object()) return;
+
+        if(data.contains("type") && data["type"] == "geometry" && data.contains("vertices") && data.contains("indices")){
+            const json& verticesData = data["vertices"];
+            const json& indicesData = data["indices"];
+
+            std::vector<Vertex> vertices;
+            vertices.reserve(verticesData.size());
+            for(const json& v : verticesData) vertices.push_back(Vertex::FromJson(v));
+
+            std::vector<unsigned int> indices;
+            indices.reserve(indicesData.size());
+            for(const json& i : indicesData) indices.push_back(i);
+
+            auto align = [&out](){
+                static const char padding[BLOB_ALIGNMENT] = {};
+                size_t position = (size_t)out.tellp();
+                size_t remainder = position % BLOB_ALIGNMENT;
+                if(remainder) out.write(padding, BLOB_ALIGNMENT - remainder);
+                return (uint64_t)out.tellp();
+            };
+
+            BlobEntry entry;
+            entry.VertexOffset = align();
+            entry.VertexCount = vertices.size();
+            out.write((const char*)vertices.data(), vertices.size() * sizeof(Vertex));
+
+            entry.IndexOffset = align();
+            entry.IndexCount = indices.size();
+            out.write((const char*)indices.data(), indices.size() * sizeof(unsigned int));
+
+            data.erase("vertices");
+            data.erase("indices");
+            data["blob"] = entries.size();
+            entries.push_back(entry);
+            return;
+        }
+
+        for(auto& [key, value] : data.items()) extractBlobs(value, out, entries);
+    }
+
+    void SceneBinary::expandBlobs(json& data, const std::vector<GeometryBlob>& blobs){
+        if(data.is_array()){
+            for(json& element : data) expandBlobs(element, blobs);
+            return;
+        }
+
+        if(!data.is_object()) return;
+
+        if(data.contains("type") && data["type"] == "geometry" && data.contains("blob")){
+            size_t index = data["blob"];
+            data.erase("blob");
+            if(index >= blobs.size()) return;
+
+            const GeometryBlob& blob = blobs[index];
+
+            json vertices = json::array();
+            for(size_t i = 0; i < blob.VertexCount; i++){
+                Vertex v = blob.Vertices[i];
+                vertices.push_back(v.ToJson());
+            }
+
+            json indices = json::array();
+            for(size_t i = 0; i < blob.IndexCount; i++){
+                indices.push_back(blob.Indices[i]);
+            }
+
+            data["vertices"] = std::move(vertices);
+            data["indices"] = std::move(indices);
+            return;
+        }
+
+        for(auto& [key, value] : data.items()) expandBlobs(value, blobs);
+    }
+
+    bool SceneBinary::Write(std::filesystem::path filePath, json data){
+        std::ofstream out(filePath, std::ios::binary);
+        if(!out){
+            Print(PrintCode::ERROR, "SCENE_BINARY", "Failed to open file for writing at " + filePath.string());
+            return false;
+        }
+
+        //Header is written last once offsets are known
+        Header header = {};
+        out.write((const char*)&header, sizeof(Header));
+
+        std::vector<BlobEntry> entries;
+        extractBlobs(data, out, entries);
+
+        header.BlobTableOffset = (uint64_t)out.tellp();
+        out.write((const char*)entries.data(), entries.size() * sizeof(BlobEntry));
+
+        std::vector<uint8_t> tableData = json::to_cbor(data);
+        header.TableOffset = (uint64_t)out.tellp();
+        header.TableSize = tableData.size();
+        out.write((const char*)tableData.data(), tableData.size());
+
+        std::memcpy(header.Magic, MAGIC, sizeof(MAGIC));
+        header.Version = VERSION;
+        header.BlobCount = (uint32_t)entries.size();
+        out.seekp(0);
+        out.write((const char*)&header, sizeof(Header));
+
+        if(!out){
+            Print(PrintCode::ERROR, "SCENE_BINARY", "Failed to write binary scene to " + filePath.string());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool SceneBinary::Read(MappedFile& file, json& table, std::vector<GeometryBlob>& blobs){
+        const unsigned char* data = file.GetData();
+        size_t size = file.GetSize();
+
+        if(size < sizeof(Header)) return false;
+
+        Header header;
+        std::memcpy(&header, data, sizeof(Header));
+        if(std::memcmp(header.Magic, MAGIC, sizeof(MAGIC)) != 0 || header.Version != VERSION){
+            Print(PrintCode::ERROR, "SCENE_BINARY", "Not a binary scene, or written by an incompatible version.");
+            return false;
+        }
+
+        if(header.TableOffset > size || header.TableSize > size - header.TableOffset ||
+           header.BlobTableOffset > size || (uint64_t)header.BlobCount * sizeof(BlobEntry) > size - header.BlobTableOffset){
+            Print(PrintCode::ERROR, "SCENE_BINARY", "Binary scene is truncated.");
+            return false;
+        }
+
+        //Blob offsets are relative to the file, fix them up into pointers into the mapping
+        blobs.resize(header.BlobCount);
+        for(uint32_t i = 0; i < header.BlobCount; i++){
+            BlobEntry entry;
+            std::memcpy(&entry, data + header.BlobTableOffset + i * sizeof(BlobEntry), sizeof(BlobEntry));
+
+            if(entry.VertexOffset > size || entry.VertexCount > (size - entry.VertexOffset) / sizeof(Vertex) ||
+               entry.IndexOffset > size || entry.IndexCount > (size - entry.IndexOffset) / sizeof(unsigned int)){
+                Print(PrintCode::ERROR, "SCENE_BINARY", "Binary scene blob " + std::to_string(i) + " is out of bounds.");
+                return false;
+            }
+
+            //The mapping is page aligned, so aligned offsets give aligned pointers
+            if(entry.VertexOffset % alignof(Vertex) != 0 || entry.IndexOffset % alignof(unsigned int) != 0){
+                Print(PrintCode::ERROR, "SCENE_BINARY", "Binary scene blob " + std::to_string(i) + " is misaligned.");
+                return false;
+            }
+
+            const unsigned int* indices = (const unsigned int*)(data + entry.IndexOffset);
+            for(uint64_t j = 0; j < entry.IndexCount; j++){
+                if(indices[j] >= entry.VertexCount){
+                    Print(PrintCode::ERROR, "SCENE_BINARY", "Binary scene blob " + std::to_string(i) + " indexes past its vertices.");
+                    return false;
+                }
+            }
+
+            blobs[i].Vertices = (const Vertex*)(data + entry.VertexOffset);
+            blobs[i].VertexCount = entry.VertexCount;
+            blobs[i].Indices = indices;
+            blobs[i].IndexCount = entry.IndexCount;
+        }
+
+        table = json::from_cbor(data + header.TableOffset, data + header.TableOffset + header.TableSize, true, false);
+        if(table.is_discarded()){
+            Print(PrintCode::ERROR, "SCENE_BINARY", "Binary scene table is corrupt.");
+            return false;
+        }
+
+        return true;
+    }
+
+    std::shared_ptr<Scene> SceneBinary::Load(std::filesystem::path filePath, SceneLoadStats* stats){
+        auto start = std::chrono::steady_clock::now();
+
+        MappedFile file;
+        if(!file.Open(filePath)){
+            Print(PrintCode::ERROR, "SCENE_BINARY", "Failed to map binary scene at " + filePath.string());
+            return nullptr;
+        }
+
+        json table;
+        std::vector<GeometryBlob> blobs;
+        if(!Read(file, table, blobs)) return nullptr;
+
+        auto readEnd = std::chrono::steady_clock::now();
+
+        std::shared_ptr<Scene> result;
+        {
+            //Blobs point into the mapping, the source must not outlive it if building the scene throws
+            GeometryBlobScope blobScope(&blobs);
+            result = Scene::FromJson(table);
+        }
+
+        auto buildEnd = std::chrono::steady_clock::now();
+
+        if(stats){
+            stats->Format = "binary";
+            stats->FileBytes = file.GetSize();
+            stats->BlobBytes = 0;
+            for(const GeometryBlob& blob : blobs){
+                stats->BlobBytes += blob.VertexCount * sizeof(Vertex) + blob.IndexCount * sizeof(unsigned int);
+            }
+            stats->GeometryBlobs = (int)blobs.size();
+            stats->ReadTimeMs = std::chrono::duration<double, std::milli>(readEnd - start).count();
+            stats->BuildTimeMs = std::chrono::duration<double, std::milli>(buildEnd - readEnd).count();
+            stats->PeakResidentBytes = AllocationTracker::GetPeakResidentBytes();
+        }
+
+        return result;
+    }
+
+    json SceneBinary::ToJson(std::filesystem::path filePath){
+        MappedFile file;
+        if(!file.Open(filePath)){
+            Print(PrintCode::ERROR, "SCENE_BINARY", "Failed to map binary scene at " + filePath.string());
+            return json();
+        }
+
+        json table;
+        std::vector<GeometryBlob> blobs;
+        if(!Read(file, table, blobs)) return json();
+
+        expandBlobs(table, blobs);
+        return table;
+    }
+
+}
@@ -16,6 +16,8 @@
  */
 
 #include <GLEP/core/scene_object.hpp>
+#include <GLEP/core/transform_hierarchy.hpp>
+#include <GLEP/core/scene.hpp>
 
 namespace GLEP {
     
@@ -29,20 +31,37 @@ namespace GLEP {
         Position = _worldPosition;
         Rotation = _worldRotation;
         Scale = _worldScale;
+
+        _localPosition = Position;
+        _localRotation = Rotation;
+        _localScale = Scale;
     }
 
     void SceneObject::Add(std::unique_ptr<ObjectComponent> component){
         component->Initialize(shared_from_this());
         _components.push_back(std::move(component));
+
+        //Only objects with components are updated by the scene
+        if(_scene && _components.size() == 1) _scene->AddComponentObject(shared_from_this());
     }
 
     void SceneObject::Add(std::shared_ptr<SceneObject> object){
         object->Parent = shared_from_this();
         _children.push_back(object);
+
+        //Only the scene this object belongs to has to flatten its hierarchy again
+        if(_transformHierarchy){
+            _transformHierarchy->Attach(object.get());
+            _transformHierarchy->Invalidate();
+        }
+
+        if(_componentStore && !object->_componentStore) object->_componentStore = _componentStore;
+
+        object->UpdateTransformVectors();
     }
 
     void SceneObject::Update(){
-        UpdateTransformVectors();
+        ensureTransform();
         
         for(std::unique_ptr<ObjectComponent>& c : _components){
             if(_firstUpdate){
@@ -59,16 +78,54 @@ namespace GLEP {
 
     void SceneObject::UpdateTransformVectors(){
         if (Parent) {
-            _worldPosition = Parent->GetWorldPosition() + Position; 
-            _worldRotation = Parent->GetWorldRotation() * Rotation; 
-            _worldScale = Parent->GetWorldScale() * Scale;           
+            Parent->UpdateTransformVectors();
+            setWorldTransform(Parent->_worldPosition + Position, Parent->_worldRotation * Rotation, Parent->_worldScale * Scale);
         } else {
-            _worldPosition = Position;
-            _worldRotation = Rotation;
-            _worldScale = Scale;
+            setWorldTransform(Position, Rotation, Scale);
         }
     }
 
+    bool SceneObject::hasLocalChanged(){
+        return Position != _localPosition || Rotation != _localRotation || Scale != _localScale;
+    }
+
+    void SceneObject::refreshTransform(){
+        //Walk up the chain so a moved parent is seen before the scene's next TransformHierarchy pass, or outside any scene
+        SceneObject* parent = Parent.get();
+        if(parent) parent->refreshTransform();
+
+        unsigned int parentRevision = parent ? parent->_transformRevision : 0;
+        if(parent == _transformParent && parentRevision == _parentRevision && !hasLocalChanged()) return;
+
+        if(parent){
+            setWorldTransform(parent->_worldPosition + Position, parent->_worldRotation * Rotation, parent->_worldScale * Scale);
+        } else {
+            setWorldTransform(Position, Rotation, Scale);
+        }
+    }
+
+    void SceneObject::ensureTransform(){
+        //The scene's TransformHierarchy pass already updated objects it owns, only loose objects walk their chain
+        if(!_transformHierarchy) refreshTransform();
+    }
+
+    void SceneObject::setWorldTransform(glm::vec3 position, glm::quat rotation, glm::vec3 scale){
+        _worldPosition = position;
+        _worldRotation = rotation;
+        _worldScale = scale;
+
+        _localPosition = Position;
+        _localRotation = Rotation;
+        _localScale = Scale;
+
+        //Callers compute from an up to date parent, remember which revision of it this transform was built from
+        _transformParent = Parent.get();
+        _parentRevision = Parent ? Parent->_transformRevision : 0;
+
+        updateModelMatrix();
+        _transformRevision++;
+    }
+
     void SceneObject::updateModelMatrix(){
         glm::mat4 scaleMat = glm::scale(glm::mat4(1.0f), _worldScale);
         glm::mat4 rotationMat = glm::mat4_cast(_worldRotation);  
@@ -77,6 +134,21 @@ namespace GLEP {
         _modelMatrix = translateMat * rotationMat * scaleMat;
     }
 
+    std::string SceneObject::GetName(){ return _name; }
+    std::string SceneObject::GetTag(){ return _tag; }
+
+    void SceneObject::SetName(std::string name){
+        std::string oldName = _name;
+        _name = name;
+        if(_scene) _scene->Reindex(shared_from_this(), oldName, _tag);
+    }
+
+    void SceneObject::SetTag(std::string tag){
+        std::string oldTag = _tag;
+        _tag = tag;
+        if(_scene) _scene->Reindex(shared_from_this(), _name, oldTag);
+    }
+
     std::vector<std::unique_ptr<ObjectComponent>>& SceneObject::GetComponents(){
         return _components;
     }
@@ -86,32 +158,44 @@ namespace GLEP {
     }
 
     glm::mat4 SceneObject::GetModelMatrix(){
-        updateModelMatrix();
+        ensureTransform();
         return _modelMatrix;
     }
 
+    unsigned int SceneObject::GetTransformRevision(){ return _transformRevision; }
+
     glm::vec3 SceneObject::GetWorldPosition(){
-        UpdateTransformVectors();
+        ensureTransform();
         return _worldPosition;
     }
 
     glm::quat SceneObject::GetWorldRotation(){
-        UpdateTransformVectors();
+        ensureTransform();
         return _worldRotation;
     }
 
     glm::vec3 SceneObject::GetWorldScale(){
-        UpdateTransformVectors();
+        ensureTransform();
         return _worldScale;
     }
 
+    bool SceneObject::GetLocalBounds(AABB&){
+        return false;
+    }
+
+    unsigned int SceneObject::GetBoundsRevision(){
+        return 0;
+    }
+
     json SceneObject::ToJson(){
         json j;
 
-        j["name"] = Name;
+        j["name"] = _name;
+        j["tag"] = _tag;
         j["position"] = Math::ToJson(Position);
         j["rotation"] = Math::ToJson(Rotation);
         j["scale"] = Math::ToJson(Scale);
+        j["is_static"] = IsStatic;
 
         return j;
     }
@@ -120,20 +204,28 @@ namespace GLEP {
     std::shared_ptr<SceneObject> SceneObject::FromJson(const json& data){
         std::shared_ptr<SceneObject> result = std::make_shared<SceneObject>();
 
-        result->Name = data["name"];
+        result->_name = data["name"];
+        if(data.contains("tag"))
+            result->_tag = data["tag"];
         result->Position = Math::Vec3FromJson(data["position"]);
         result->Rotation = Math::QuatFromJson(data["rotation"]);
         result->Scale = Math::Vec3FromJson(data["scale"]);
+        if(data.contains("is_static"))
+            result->IsStatic = data["is_static"];
 
         return result;
     }
 
     //INCOMPLETE
     void SceneObject::ApplyFromJson(const std::shared_ptr<SceneObject>& object, const json& data){
-        object->Name = data["name"];
+        object->SetName(data["name"].get<std::string>());
+        if(data.contains("tag"))
+            object->SetTag(data["tag"].get<std::string>());
         object->Position = Math::Vec3FromJson(data["position"]);
         object->Rotation = Math::QuatFromJson(data["rotation"]);
         object->Scale = Math::Vec3FromJson(data["scale"]);
+        if(data.contains("is_static"))
+            object->IsStatic = data["is_static"];
     }
 
 }
\ No newline at end of file
@@ -28,8 +28,19 @@ namespace GLEP {
         initialize();
     }
 
+    Shader::Shader(std::filesystem::path vsFilePath, std::filesystem::path gsFilePath, std::filesystem::path fsFilePath){
+        _vsFilePath = vsFilePath;
+        _gsFilePath = gsFilePath;
+        _fsFilePath = fsFilePath;
+
+        initialize();
+    }
+
     Shader::~Shader(){
-        glDeleteProgram(_ID);
+        DeferredGL::Cancel(this);
+
+        unsigned int ID = _ID;
+        DeferredGL::Run(nullptr, [ID](){ glDeleteProgram(ID); });
     }
 
     bool Shader::readFiles(){
@@ -53,6 +64,17 @@ namespace GLEP {
 
             vertexCode   = vShaderStream.str();
             fragmentCode = fShaderStream.str();
+
+            if(!_gsFilePath.empty()){
+                std::ifstream gShaderFile;
+                gShaderFile.exceptions (std::ifstream::failbit | std::ifstream::badbit);
+                gShaderFile.open(_gsFilePath.string());
+                std::stringstream gShaderStream;
+                gShaderStream << gShaderFile.rdbuf();
+                gShaderFile.close();
+
+                _gsSrc = gShaderStream.str();
+            }
         }
         catch (std::ifstream::failure& e)
         {
@@ -77,6 +99,7 @@ namespace GLEP {
                 
                 std::filesystem::path path;
                 if(type == "VERTEX") path = _vsFilePath;
+                else if(type == "GEOMETRY") path = _gsFilePath;
                 else path = _fsFilePath;
 
                 Print(PrintCode::ERROR, "SHADER", "Failed to compile " + type + " shader at " + path.string() + ": \n" + infoLog + "\n -- --------------------------------------------------- -- ");
@@ -98,8 +121,15 @@ namespace GLEP {
 
 
     bool Shader::initialize(){
-        readFiles();
+        bool success = readFiles();
+
+        //Sources are read on this thread, compiling may be deferred to the GL context thread
+        DeferredGL::Run(this, [this](){ compile(); });
+
+        return success;
+    }
 
+    bool Shader::compile(){
         unsigned int vertex, fragment;
         
         /* VERTEX SHADER */
@@ -111,6 +141,18 @@ namespace GLEP {
             return false;
         }
 
+        /* GEOMETRY SHADER */
+        unsigned int geometry = 0;
+        if(!_gsFilePath.empty()){
+            geometry = glCreateShader(GL_GEOMETRY_SHADER);
+            const char* gsSource = _gsSrc.c_str();
+            glShaderSource(geometry, 1, &gsSource, NULL);
+            glCompileShader(geometry);
+            if(!checkCompileErrors(geometry, "GEOMETRY")) {
+                return false;
+            }
+        }
+
         /* FRAGEMENT SHADER */
         fragment = glCreateShader(GL_FRAGMENT_SHADER);
         const char* fsSource = _fsSrc.c_str();
@@ -124,6 +166,7 @@ namespace GLEP {
         _ID = glCreateProgram();
         glAttachShader(_ID, vertex);
         glAttachShader(_ID, fragment);
+        if(geometry) glAttachShader(_ID, geometry);
         glLinkProgram(_ID);
         if(!checkCompileErrors(_ID, "PROGRAM")) {
             return false;
@@ -131,12 +174,26 @@ namespace GLEP {
 
         glDeleteShader(vertex);
         glDeleteShader(fragment);
+        if(geometry) glDeleteShader(geometry);
 
         glUseProgram(_ID);
 
         return true;
     }
 
+    std::shared_ptr<Shader> Shader::FromSource(const std::string& vsSource, const std::string& fsSource, const std::string& name){
+        std::shared_ptr<Shader> shader = std::make_shared<Shader>();
+        shader->_vsFilePath = name;
+        shader->_fsFilePath = name;
+        shader->_vsSrc = vsSource;
+        shader->_fsSrc = fsSource;
+
+        Shader* s = shader.get();
+        DeferredGL::Run(s, [s](){ s->compile(); });
+
+        return shader;
+    }
+
     void Shader::Use(){
         glUseProgram(_ID);
     }
@@ -152,4 +209,11 @@ namespace GLEP {
     std::filesystem::path Shader::GetFsPath(){
         return _fsFilePath;
     }
-}
\ No newline at end of file
+
+    std::filesystem::path Shader::GetGsPath(){
+        return _gsFilePath;
+    }
+
+    const std::string& Shader::GetVsSource(){ return _vsSrc; }
+    const std::string& Shader::GetFsSource(){ return _fsSrc; }
+}
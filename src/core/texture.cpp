@@ -33,11 +33,16 @@ namespace GLEP {
             _filePath = File::GLEP_DEFUALT_TEXTURE;
         }
         
-        initialize(data);
+        //Decoding stays on this thread, the upload may be deferred to the GL context thread
+        std::shared_ptr<unsigned char> pixels(data, stbi_image_free);
+        DeferredGL::Run(this, [this, pixels](){ initialize(pixels.get()); });
     }
 
     Texture::~Texture() {
-        glDeleteTextures(1, &_ID);
+        DeferredGL::Cancel(this);
+
+        unsigned int ID = _ID;
+        DeferredGL::Run(nullptr, [ID](){ glDeleteTextures(1, &ID); });
     }
 
     void Texture::initialize(unsigned char *data){
@@ -59,8 +64,6 @@ namespace GLEP {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
     }
 
     void Texture::SetWrap(TextureWrap wrap){
@@ -0,0 +1,113 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <GLEP/core/transform_hierarchy.hpp>
+
+namespace GLEP {
+
+    TransformHierarchy::TransformHierarchy(){}
+
+    int TransformHierarchy::GetCount(){ return (int)_objects.size(); }
+
+    void TransformHierarchy::Invalidate(){
+        _needsRebuild = true;
+    }
+
+    void TransformHierarchy::Attach(SceneObject* object){
+        object->_transformHierarchy = this;
+        for(std::shared_ptr<SceneObject>& child : object->GetChildren()){
+            Attach(child.get());
+        }
+    }
+
+    void TransformHierarchy::Detach(SceneObject* object){
+        if(object->_transformHierarchy == this) object->_transformHierarchy = nullptr;
+        for(std::shared_ptr<SceneObject>& child : object->GetChildren()){
+            Detach(child.get());
+        }
+    }
+
+    void TransformHierarchy::addRecursive(SceneObject* object, int parent){
+        if(_indices.count(object)) return;
+
+        int index = (int)_objects.size();
+        _objects.push_back(object);
+        _parents.push_back(parent);
+        _indices[object] = index;
+
+        for(std::shared_ptr<SceneObject>& child : object->GetChildren()){
+            addRecursive(child.get(), index);
+        }
+    }
+
+    void TransformHierarchy::Rebuild(const std::vector<std::shared_ptr<SceneObject>>& objects){
+        _objects.clear();
+        _parents.clear();
+        _indices.clear();
+
+        //Roots first, scene objects that are also children are reached through their parent
+        for(const std::shared_ptr<SceneObject>& o : objects){
+            if(!o->Parent) addRecursive(o.get(), -1);
+        }
+
+        for(const std::shared_ptr<SceneObject>& o : objects){
+            if(o->Parent && !_indices.count(o.get())) addRecursive(o.get(), EXTERNAL_PARENT);
+        }
+
+        _needsRebuild = false;
+    }
+
+    int TransformHierarchy::Update(const std::vector<std::shared_ptr<SceneObject>>& objects){
+        if(_needsRebuild) Rebuild(objects);
+
+        int updated = 0;
+        for(int i = 0; i < _objects.size(); i++){
+            SceneObject* object = _objects[i];
+            int parent = _parents[i];
+
+            if(parent == EXTERNAL_PARENT){
+                //Parent isn't part of this scene, fall back to walking up its chain
+                unsigned int revision = object->_transformRevision;
+                object->refreshTransform();
+                if(object->_transformRevision != revision) updated++;
+                continue;
+            }
+
+            if(parent < 0){
+                if(!object->hasLocalChanged() && !object->_transformParent) continue;
+
+                object->setWorldTransform(object->Position, object->Rotation, object->Scale);
+                updated++;
+                continue;
+            }
+
+            SceneObject* parentObject = _objects[parent];
+            if(!object->hasLocalChanged() && object->_transformParent == parentObject && object->_parentRevision == parentObject->_transformRevision) continue;
+
+            object->setWorldTransform(
+                parentObject->_worldPosition + object->Position,
+                parentObject->_worldRotation * object->Rotation,
+                parentObject->_worldScale * object->Scale
+            );
+            updated++;
+        }
+
+        return updated;
+    }
+
+}
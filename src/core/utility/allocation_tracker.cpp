@@ -0,0 +1,168 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <GLEP/core/utility/allocation_tracker.hpp>
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace GLEP{
+
+    static thread_local size_t threadAllocations = 0;
+    static thread_local size_t threadBytes = 0;
+
+    bool AllocationTracker::IsEnabled(){
+        #ifdef GLEP_TRACK_ALLOCATIONS
+        return true;
+        #else
+        return false;
+        #endif
+    }
+
+    AllocationStats AllocationTracker::GetThreadStats(){
+        AllocationStats stats;
+        stats.Allocations = threadAllocations;
+        stats.Bytes = threadBytes;
+        return stats;
+    }
+
+    size_t AllocationTracker::GetPeakResidentBytes(){
+        #ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+        return counters.PeakWorkingSetSize;
+        #else
+        struct rusage usage;
+        if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+        //Reported in bytes on macOS and kilobytes everywhere else
+        #ifdef __APPLE__
+        return (size_t)usage.ru_maxrss;
+        #else
+        return (size_t)usage.ru_maxrss * 1024;
+        #endif
+        #endif
+    }
+
+    void AllocationTracker::Record(size_t bytes){
+        threadAllocations++;
+        threadBytes += bytes;
+    }
+
+}
+
+#ifdef GLEP_TRACK_ALLOCATIONS
+
+void* operator new(std::size_t size){
+    GLEP::AllocationTracker::Record(size);
+
+    if(size == 0) size = 1;
+    while(true){
+        void* memory = std::malloc(size);
+        if(memory) return memory;
+
+        std::new_handler handler = std::get_new_handler();
+        if(!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size){
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept{
+    try {
+        return ::operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept{
+    return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void* memory) noexcept{ std::free(memory); }
+void operator delete[](void* memory) noexcept{ std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept{ std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept{ std::free(memory); }
+
+//Over-aligned types (alignas above the default new alignment) use these overloads
+static void* alignedAllocate(std::size_t size, std::size_t alignment){
+    #ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+    #else
+    //aligned_alloc requires the size to be a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    #endif
+}
+
+static void alignedFree(void* memory){
+    #ifdef _WIN32
+    _aligned_free(memory);
+    #else
+    std::free(memory);
+    #endif
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment){
+    GLEP::AllocationTracker::Record(size);
+
+    if(size == 0) size = 1;
+    while(true){
+        void* memory = alignedAllocate(size, (std::size_t)alignment);
+        if(memory) return memory;
+
+        std::new_handler handler = std::get_new_handler();
+        if(!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment){
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept{
+    try {
+        return ::operator new(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept{
+    return ::operator new(size, alignment, std::nothrow);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept{ alignedFree(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept{ alignedFree(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept{ alignedFree(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept{ alignedFree(memory); }
+
+#endif
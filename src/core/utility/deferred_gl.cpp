@@ -0,0 +1,61 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <GLEP/core/utility/deferred_gl.hpp>
+
+#include <algorithm>
+
+namespace GLEP{
+
+    thread_local DeferredGLTaskList* DeferredGL::_recording = nullptr;
+
+    void DeferredGL::Begin(DeferredGLTaskList* tasks){
+        _recording = tasks;
+    }
+
+    void DeferredGL::End(){
+        _recording = nullptr;
+    }
+
+    bool DeferredGL::IsRecording(){
+        return _recording != nullptr;
+    }
+
+    void DeferredGL::Run(const void* owner, std::function<void()> task){
+        if(_recording){
+            _recording->push_back({owner, std::move(task)});
+            return;
+        }
+
+        task();
+    }
+
+    void DeferredGL::Cancel(const void* owner){
+        if(!_recording || !owner) return;
+
+        _recording->erase(std::remove_if(_recording->begin(), _recording->end(), [owner](const DeferredGLTask& t){ return t.Owner == owner; }), _recording->end());
+    }
+
+    void DeferredGL::Execute(DeferredGLTaskList& tasks){
+        for(DeferredGLTask& t : tasks){
+            t.Function();
+        }
+        tasks.clear();
+    }
+
+}
@@ -37,9 +37,8 @@ namespace GLEP{
 
         Print(PrintCode::INFO, "EXPORT", "Exporting Scene to " + targetPath.string());
 
-        json j = scene->ToJson();
-
-        outFile << std::setw(2) << j << std::endl;
+        scene->WriteJson(outFile, 2);
+        outFile << std::endl;
 
         outFile.close();
 
@@ -48,6 +47,26 @@ namespace GLEP{
         return true;
     }
 
+    bool Export::SceneToBinaryFile(std::filesystem::path targetPath, const std::shared_ptr<Scene>& scene){
+        if (!scene) {
+            Print(PrintCode::ERROR, "EXPORT", "Scene attempted to export but is null.");
+            return false;
+        }
+
+        if(!targetPath.has_extension()) targetPath += SceneBinary::EXTENSION;
+
+        Print(PrintCode::INFO, "EXPORT", "Exporting Scene to " + targetPath.string());
+
+        if(!SceneBinary::Write(targetPath, scene->ToJson())){
+            Print(PrintCode::ERROR, "EXPORT", "Failed to export Scene to " + targetPath.string());
+            return false;
+        }
+
+        Print(PrintCode::INFO, "EXPORT", "Scene export complete to " + targetPath.string());
+
+        return true;
+    }
+
     void Export::ColorBufferToJPG(std::filesystem::path targetPath, const std::shared_ptr<Framebuffer>& framebuffer,  int quality){
         if(!targetPath.has_extension()) targetPath += ".jpg";
 
@@ -0,0 +1,199 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <GLEP/core/utility/json_stream.hpp>
+#include <GLEP/core/utility/print.hpp>
+
+namespace GLEP{
+
+    JsonStreamWriter::JsonStreamWriter(std::ostream& stream, unsigned int indent) : _stream(stream), _indent(indent){}
+
+    void JsonStreamWriter::separate(const std::string* key){
+        if(!_empty.empty()){
+            if(!_empty.back()) _stream << ',';
+            _empty.back() = false;
+            _stream << '\n' << std::string(_empty.size() * _indent, ' ');
+        }
+
+        if(key){
+            _stream << json(*key).dump() << ": ";
+        }
+    }
+
+    void JsonStreamWriter::begin(const std::string* key, char open){
+        separate(key);
+        _stream << open;
+        _empty.push_back(true);
+    }
+
+    void JsonStreamWriter::end(char close){
+        bool empty = _empty.back();
+        _empty.pop_back();
+
+        if(!empty){
+            _stream << '\n' << std::string(_empty.size() * _indent, ' ');
+        }
+        _stream << close;
+    }
+
+    void JsonStreamWriter::BeginObject(){ begin(nullptr, '{'); }
+
+    void JsonStreamWriter::BeginObject(const std::string& key){ begin(&key, '{'); }
+
+    void JsonStreamWriter::EndObject(){ end('}'); }
+
+    void JsonStreamWriter::BeginArray(){ begin(nullptr, '['); }
+
+    void JsonStreamWriter::BeginArray(const std::string& key){ begin(&key, '['); }
+
+    void JsonStreamWriter::EndArray(){ end(']'); }
+
+    void JsonStreamWriter::write(const std::string* key, const json& value){
+        separate(key);
+
+        //Serialize straight into the stream, indented to the current depth
+        nlohmann::detail::serializer<json> serializer(nlohmann::detail::output_adapter<char>(_stream), ' ');
+        serializer.dump(value, true, false, _indent, (unsigned int)(_empty.size() * _indent));
+    }
+
+    void JsonStreamWriter::Value(const json& value){ write(nullptr, value); }
+
+    void JsonStreamWriter::Value(const std::string& key, const json& value){ write(&key, value); }
+
+
+    JsonStreamReader::JsonStreamReader(Callback onElement, Callback onValue) : _onElement(onElement), _onValue(onValue){}
+
+    bool JsonStreamReader::Parse(std::istream& stream){
+        _depth = 0;
+        _inArray = false;
+        _stack.clear();
+        _member = nullptr;
+        _value = json();
+
+        return json::sax_parse(stream, this);
+    }
+
+    bool JsonStreamReader::deliver(){
+        bool result = _inArray ? _onElement(_key, _value) : _onValue(_key, _value);
+        _value = json();
+        return result;
+    }
+
+    bool JsonStreamReader::value(json&& value){
+        if(_depth == 0){
+            Print(PrintCode::ERROR, "JSON", "Streamed JSON root must be an object");
+            return false;
+        }
+
+        if(_stack.empty()){
+            _value = std::move(value);
+            return deliver();
+        }
+
+        if(_stack.back()->is_array()){
+            _stack.back()->push_back(std::move(value));
+        } else {
+            *_member = std::move(value);
+        }
+        return true;
+    }
+
+    bool JsonStreamReader::open(json&& container){
+        if(_stack.empty()){
+            _value = std::move(container);
+            _stack.push_back(&_value);
+        } else if(_stack.back()->is_array()){
+            _stack.back()->push_back(std::move(container));
+            _stack.push_back(&_stack.back()->back());
+        } else {
+            *_member = std::move(container);
+            _stack.push_back(_member);
+        }
+        return true;
+    }
+
+    bool JsonStreamReader::close(){
+        _stack.pop_back();
+        if(_stack.empty())
+            return deliver();
+        return true;
+    }
+
+    bool JsonStreamReader::null(){ return value(json()); }
+
+    bool JsonStreamReader::boolean(bool val){ return value(json(val)); }
+
+    bool JsonStreamReader::number_integer(number_integer_t val){ return value(json(val)); }
+
+    bool JsonStreamReader::number_unsigned(number_unsigned_t val){ return value(json(val)); }
+
+    bool JsonStreamReader::number_float(number_float_t val, const string_t& s){ return value(json(val)); }
+
+    bool JsonStreamReader::string(string_t& val){ return value(json(std::move(val))); }
+
+    bool JsonStreamReader::binary(binary_t& val){ return value(json::binary(std::move(val))); }
+
+    bool JsonStreamReader::start_object(std::size_t elements){
+        //The root object itself is never built, only its members
+        if(_depth++ == 0)
+            return true;
+        return open(json::object());
+    }
+
+    bool JsonStreamReader::key(string_t& val){
+        if(_depth == 1){
+            _key = val;
+        } else {
+            _member = &(*_stack.back())[val];
+        }
+        return true;
+    }
+
+    bool JsonStreamReader::end_object(){
+        if(--_depth == 0)
+            return true;
+        return close();
+    }
+
+    bool JsonStreamReader::start_array(std::size_t elements){
+        if(_depth == 0){
+            Print(PrintCode::ERROR, "JSON", "Streamed JSON root must be an object");
+            return false;
+        }
+
+        //Arrays directly under the root are handed over one element at a time
+        if(++_depth == 2){
+            _inArray = true;
+            return true;
+        }
+        return open(json::array());
+    }
+
+    bool JsonStreamReader::end_array(){
+        if(--_depth == 1){
+            _inArray = false;
+            return true;
+        }
+        return close();
+    }
+
+    bool JsonStreamReader::parse_error(std::size_t position, const std::string& last_token, const nlohmann::detail::exception& ex){
+        Print(PrintCode::ERROR, "JSON", "Failed to parse JSON stream at byte " + std::to_string(position) + ": " + ex.what());
+        return false;
+    }
+}
@@ -0,0 +1,120 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <GLEP/core/utility/mapped_file.hpp>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace GLEP{
+
+    MappedFile::MappedFile(){}
+
+    MappedFile::~MappedFile(){
+        Close();
+    }
+
+    bool MappedFile::Open(std::filesystem::path filePath){
+        Close();
+
+        #ifdef _WIN32
+        HANDLE file = CreateFileW(filePath.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if(file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size;
+        if(!GetFileSizeEx(file, &size) || size.QuadPart == 0){
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(!mapping){
+            CloseHandle(file);
+            return false;
+        }
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if(!data){
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        _fileHandle = file;
+        _mappingHandle = mapping;
+        _data = (const unsigned char*)data;
+        _size = (size_t)size.QuadPart;
+        #else
+        int fd = open(filePath.c_str(), O_RDONLY);
+        if(fd < 0) return false;
+
+        struct stat info;
+        if(fstat(fd, &info) != 0 || info.st_size == 0){
+            close(fd);
+            return false;
+        }
+
+        void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED){
+            close(fd);
+            return false;
+        }
+
+        //Blobs are read front to back once
+        madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+        _fileDescriptor = fd;
+        _data = (const unsigned char*)data;
+        _size = (size_t)info.st_size;
+        #endif
+
+        return true;
+    }
+
+    void MappedFile::Close(){
+        if(!_data) return;
+
+        #ifdef _WIN32
+        UnmapViewOfFile(_data);
+        CloseHandle(_mappingHandle);
+        CloseHandle(_fileHandle);
+        _mappingHandle = nullptr;
+        _fileHandle = nullptr;
+        #else
+        munmap((void*)_data, _size);
+        close(_fileDescriptor);
+        _fileDescriptor = -1;
+        #endif
+
+        _data = nullptr;
+        _size = 0;
+    }
+
+    const unsigned char* MappedFile::GetData(){ return _data; }
+
+    size_t MappedFile::GetSize(){ return _size; }
+
+}
@@ -68,4 +68,136 @@ namespace GLEP{
     glm::quat Math::QuatFromJson(const json& data){
         return glm::quat(data["w"], data["x"], data["y"], data["z"]);
     }
+
+    void Math::BoundsToSphere(glm::vec3 boundsMin, glm::vec3 boundsMax, const glm::mat4& transform, glm::vec3& center, float& radius){
+        center = glm::vec3(transform * glm::vec4((boundsMin + boundsMax) * 0.5f, 1.0f));
+
+        float maxScale = std::max(glm::length(glm::vec3(transform[0])), std::max(glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))));
+        radius = glm::length((boundsMax - boundsMin) * 0.5f) * maxScale;
+    }
+
+    AABB::AABB(){}
+
+    AABB::AABB(glm::vec3 min, glm::vec3 max){
+        Min = min;
+        Max = max;
+    }
+
+    bool AABB::IsValid() const{
+        return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z;
+    }
+
+    glm::vec3 AABB::GetCenter() const{
+        return (Min + Max) * 0.5f;
+    }
+
+    float AABB::GetSurfaceArea() const{
+        if(!IsValid()) return 0.0f;
+        glm::vec3 size = Max - Min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    void AABB::Expand(glm::vec3 point){
+        Min = glm::min(Min, point);
+        Max = glm::max(Max, point);
+    }
+
+    void AABB::Expand(const AABB& other){
+        Min = glm::min(Min, other.Min);
+        Max = glm::max(Max, other.Max);
+    }
+
+    AABB AABB::Transform(const glm::mat4& transform) const{
+        if(!IsValid()) return AABB();
+
+        //Arvo's method, project each axis of the box instead of transforming all eight corners
+        glm::vec3 translation = glm::vec3(transform[3]);
+        AABB result(translation, translation);
+        for(int col = 0; col < 3; col++){
+            for(int row = 0; row < 3; row++){
+                float a = transform[col][row] * Min[col];
+                float b = transform[col][row] * Max[col];
+                result.Min[row] += std::min(a, b);
+                result.Max[row] += std::max(a, b);
+            }
+        }
+
+        return result;
+    }
+
+    bool AABB::Intersects(const AABB& other) const{
+        return Min.x <= other.Max.x && Max.x >= other.Min.x &&
+               Min.y <= other.Max.y && Max.y >= other.Min.y &&
+               Min.z <= other.Max.z && Max.z >= other.Min.z;
+    }
+
+    bool AABB::IntersectsSphere(glm::vec3 center, float radius) const{
+        glm::vec3 closest = glm::clamp(center, Min, Max);
+        glm::vec3 offset = center - closest;
+        return glm::dot(offset, offset) <= radius * radius;
+    }
+
+    bool AABB::IntersectsRay(glm::vec3 origin, glm::vec3 inverseDirection, float maxDistance, float& distance) const{
+        glm::vec3 t0 = (Min - origin) * inverseDirection;
+        glm::vec3 t1 = (Max - origin) * inverseDirection;
+        glm::vec3 tMin = glm::min(t0, t1);
+        glm::vec3 tMax = glm::max(t0, t1);
+
+        float enter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+        float exit = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+
+        distance = enter;
+        return enter <= exit;
+    }
+
+    AABB AABB::Union(const AABB& a, const AABB& b){
+        return AABB(glm::min(a.Min, b.Min), glm::max(a.Max, b.Max));
+    }
+
+    Frustum Frustum::FromMatrix(const glm::mat4& m){
+        Frustum result;
+        glm::vec4 rowX = glm::vec4(m[0][0], m[1][0], m[2][0], m[3][0]);
+        glm::vec4 rowY = glm::vec4(m[0][1], m[1][1], m[2][1], m[3][1]);
+        glm::vec4 rowZ = glm::vec4(m[0][2], m[1][2], m[2][2], m[3][2]);
+        glm::vec4 rowW = glm::vec4(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+        result.Planes[0] = rowW + rowX;
+        result.Planes[1] = rowW - rowX;
+        result.Planes[2] = rowW + rowY;
+        result.Planes[3] = rowW - rowY;
+        result.Planes[4] = rowW + rowZ;
+        result.Planes[5] = rowW - rowZ;
+
+        for(int i = 0; i < 6; i++){
+            float length = glm::length(glm::vec3(result.Planes[i]));
+            if(length > 0.0f) result.Planes[i] /= length;
+        }
+
+        return result;
+    }
+
+    bool Frustum::IntersectsAABB(const AABB& bounds) const{
+        for(int i = 0; i < 6; i++){
+            //Test the corner furthest along the plane normal
+            glm::vec3 positive = glm::vec3(
+                Planes[i].x >= 0.0f ? bounds.Max.x : bounds.Min.x,
+                Planes[i].y >= 0.0f ? bounds.Max.y : bounds.Min.y,
+                Planes[i].z >= 0.0f ? bounds.Max.z : bounds.Min.z
+            );
+
+            if(glm::dot(glm::vec3(Planes[i]), positive) + Planes[i].w < 0.0f)
+                return false;
+        }
+
+        return true;
+    }
+
+    bool Frustum::IntersectsSphere(glm::vec3 center, float radius) const{
+        for(int i = 0; i < 6; i++){
+            if(glm::dot(glm::vec3(Planes[i]), center) + Planes[i].w < -radius)
+                return false;
+        }
+
+        return true;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,447 @@
+/* GLEP - OpenGL Engine Platform
+ * Copyright (C) 2025 Jasper Devir <jasperdevir.jd@gmail.com>
+ *
+ * GLEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GLEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GLEP.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <GLEP/core/world_partition.hpp>
+#include <GLEP/core/scene.hpp>
+#include <GLEP/core/scene_binary.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+#include <map>
+
+namespace GLEP {
+
+    static size_t estimateGpuBytes(const std::shared_ptr<SceneObject>& object){
+        std::shared_ptr<Model> model = std::dynamic_pointer_cast<Model>(object);
+        if(!model) return 0;
+
+        //Only vertex and index buffers are counted, textures can be accounted for in the manifest
+        size_t bytes = 0;
+        for(const std::shared_ptr<Mesh>& m : model->GetMeshes()){
+            if(!m->GeometryData) continue;
+            bytes += m->GeometryData->GetVertexCount() * sizeof(Vertex) + m->GeometryData->GetIndexCount() * sizeof(unsigned int);
+        }
+
+        return bytes;
+    }
+
+    WorldPartition::WorldPartition(){}
+
+    WorldPartition::~WorldPartition(){
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _condition.notify_all();
+
+        if(_worker.joinable()) _worker.join();
+    }
+
+    const std::vector<PartitionCell>& WorldPartition::GetCells(){ return _cells; }
+
+    WorldPartitionStats WorldPartition::GetStats(){ return _stats; }
+
+    void WorldPartition::workerLoop(){
+        while(true){
+            int index;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this](){ return _stopping || !_requests.empty(); });
+                if(_stopping) return;
+
+                index = _requests.front();
+                _requests.pop_front();
+            }
+
+            readCell(_cells[index]);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _completed.push_back(index);
+        }
+    }
+
+    void WorldPartition::readCell(PartitionCell& cell){
+        std::filesystem::path path = _directory / cell.Path;
+
+        json table;
+        MappedFile file;
+        std::vector<GeometryBlob> blobs;
+
+        if(path.extension() == SceneBinary::EXTENSION){
+            if(!file.Open(path) || !SceneBinary::Read(file, table, blobs)){
+                Print(PrintCode::ERROR, "WORLD_PARTITION", "Failed to read cell at " + path.string());
+                return;
+            }
+        } else {
+            std::ifstream f(path);
+            if(!f){
+                Print(PrintCode::ERROR, "WORLD_PARTITION", "Failed to read cell at " + path.string());
+                return;
+            }
+
+            table = json::parse(f, nullptr, false);
+            if(table.is_discarded()){
+                Print(PrintCode::ERROR, "WORLD_PARTITION", "Failed to parse cell at " + path.string());
+                return;
+            }
+        }
+
+        const json& objects = table["objects"];
+        if(!objects.is_array()) return;
+
+        //Build objects here like a parallel scene load, only recorded GL work is left for the render thread
+        GeometryBlobScope blobScope(&blobs);
+        cell.Objects.reserve(objects.size());
+        cell.GlTasks.reserve(objects.size());
+        for(const json& o : objects){
+            DeferredGLTaskList tasks;
+            DeferredGL::Begin(&tasks);
+            try {
+                std::shared_ptr<SceneObject> object = Scene::ObjectFromJson(o);
+                if(object){
+                    cell.Objects.push_back(object);
+                    cell.GlTasks.push_back(std::move(tasks));
+                }
+            } catch (const std::exception& e) {
+                Print(PrintCode::ERROR, "WORLD_PARTITION", "Failed to build object in cell at " + path.string() + ": " + e.what());
+            }
+            DeferredGL::End();
+        }
+    }
+
+    float WorldPartition::cellDistance(const PartitionCell& cell, glm::vec3 position){
+        glm::vec2 min = glm::vec2(cell.Coord) * CellSize;
+        glm::vec2 max = min + glm::vec2(CellSize);
+        glm::vec2 point = glm::vec2(position.x, position.z);
+
+        return glm::length(point - glm::clamp(point, min, max));
+    }
+
+    void WorldPartition::request(int index){
+        _cells[index].State = CellState::READING;
+        _cells[index].Cancelled = false;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _requests.push_back(index);
+        }
+
+        if(!_worker.joinable()) _worker = std::thread(&WorldPartition::workerLoop, this);
+        _condition.notify_one();
+    }
+
+    void WorldPartition::evict(int index){
+        PartitionCell& cell = _cells[index];
+
+        switch(cell.State){
+            case CellState::READING:
+                //Dropped once the worker is done with it
+                cell.Cancelled = true;
+                break;
+
+            case CellState::INSTANTIATING:
+            case CellState::LOADED:
+                //Objects that never reached the scene are dropped along with their GL work
+                cell.GlTasks.clear();
+                cell.Objects.resize(cell.NextObject);
+                cell.NextObject = 0;
+                cell.State = CellState::EVICTING;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    bool WorldPartition::outOfTime(){
+        //Always make some progress, even if the budget is smaller than a single object
+        if(!_stats.ObjectsAdded && !_stats.ObjectsRemoved) return false;
+        return std::chrono::steady_clock::now() >= _deadline;
+    }
+
+    void WorldPartition::instantiate(Scene& scene){
+        for(PartitionCell& cell : _cells){
+            if(cell.State != CellState::INSTANTIATING) continue;
+
+            for(; cell.NextObject < cell.Objects.size(); cell.NextObject++){
+                if(outOfTime()) return;
+
+                DeferredGL::Execute(cell.GlTasks[cell.NextObject]);
+                scene.Add(cell.Objects[cell.NextObject]);
+                _stats.ObjectsAdded++;
+            }
+
+            size_t gpuBytes = 0;
+            for(std::shared_ptr<SceneObject>& o : cell.Objects) gpuBytes += estimateGpuBytes(o);
+            cell.GpuBytes = std::max(cell.GpuBytes, gpuBytes);
+
+            cell.GlTasks.clear();
+            cell.GlTasks.shrink_to_fit();
+            cell.State = CellState::LOADED;
+        }
+    }
+
+    void WorldPartition::remove(Scene& scene){
+        for(PartitionCell& cell : _cells){
+            if(cell.State != CellState::EVICTING) continue;
+
+            while(!cell.Objects.empty()){
+                if(outOfTime()) return;
+
+                scene.Remove(cell.Objects.back());
+                cell.Objects.pop_back();
+                _stats.ObjectsRemoved++;
+            }
+
+            cell.State = CellState::UNLOADED;
+        }
+    }
+
+    void WorldPartition::Update(Scene& scene, glm::vec3 position){
+        _stats.ObjectsAdded = 0;
+        _stats.ObjectsRemoved = 0;
+
+        _processing.clear();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _processing.swap(_completed);
+        }
+
+        for(int index : _processing){
+            PartitionCell& cell = _cells[index];
+            if(cell.Cancelled){
+                cell.GlTasks.clear();
+                cell.Objects.clear();
+                cell.Cancelled = false;
+                cell.State = CellState::UNLOADED;
+            } else {
+                cell.NextObject = 0;
+                cell.State = CellState::INSTANTIATING;
+            }
+        }
+
+        std::vector<float>& distances = _distances;
+        distances.resize(_cells.size());
+        for(int i = 0; i < _cells.size(); i++){
+            distances[i] = cellDistance(_cells[i], position);
+
+            bool resident = _cells[i].State != CellState::UNLOADED && _cells[i].State != CellState::EVICTING && !_cells[i].Cancelled;
+            if(resident && distances[i] > StreamingRadius + EvictionMargin) evict(i);
+
+            //Came back into range before the worker finished reading it
+            if(_cells[i].Cancelled && distances[i] <= StreamingRadius) _cells[i].Cancelled = false;
+        }
+
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+        std::vector<int>& resident = _resident;
+        std::vector<int>& candidates = _candidates;
+        resident.clear();
+        candidates.clear();
+        for(int i = 0; i < _cells.size(); i++){
+            const PartitionCell& cell = _cells[i];
+
+            if(cell.State == CellState::UNLOADED){
+                if(distances[i] <= StreamingRadius) candidates.push_back(i);
+            } else if(cell.State != CellState::EVICTING && !cell.Cancelled){
+                cpuBytes += cell.CpuBytes;
+                gpuBytes += cell.GpuBytes;
+                resident.push_back(i);
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [&distances](int a, int b){ return distances[a] < distances[b]; });
+        std::sort(resident.begin(), resident.end(), [&distances](int a, int b){ return distances[a] > distances[b]; });
+
+        for(int index : candidates){
+            const PartitionCell& cell = _cells[index];
+            auto fits = [&](){
+                return (!CpuBudget || cpuBytes + cell.CpuBytes <= CpuBudget) && (!GpuBudget || gpuBytes + cell.GpuBytes <= GpuBudget);
+            };
+
+            //Make room by dropping resident cells further away than this one
+            while(!fits() && !resident.empty() && distances[resident.front()] > distances[index]){
+                cpuBytes -= _cells[resident.front()].CpuBytes;
+                gpuBytes -= _cells[resident.front()].GpuBytes;
+                evict(resident.front());
+                resident.erase(resident.begin());
+            }
+
+            if(!fits()) break;
+
+            cpuBytes += cell.CpuBytes;
+            gpuBytes += cell.GpuBytes;
+            request(index);
+        }
+
+        _deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float, std::milli>(FrameBudgetMs));
+        remove(scene);
+        instantiate(scene);
+
+        _stats.LoadedCells = 0;
+        _stats.PendingCells = 0;
+        for(const PartitionCell& cell : _cells){
+            if(cell.State == CellState::LOADED) _stats.LoadedCells++;
+            else if(cell.State == CellState::READING || cell.State == CellState::INSTANTIATING) _stats.PendingCells++;
+        }
+        _stats.CpuBytes = cpuBytes;
+        _stats.GpuBytes = gpuBytes;
+    }
+
+    void WorldPartition::UnloadAll(Scene& scene){
+        for(int i = 0; i < _cells.size(); i++){
+            evict(i);
+        }
+
+        _deadline = std::chrono::steady_clock::time_point::max();
+        remove(scene);
+    }
+
+    json WorldPartition::ToJson(){
+        json j;
+        j["cell_size"] = CellSize;
+        j["streaming_radius"] = StreamingRadius;
+        j["eviction_margin"] = EvictionMargin;
+        j["cpu_budget"] = CpuBudget;
+        j["gpu_budget"] = GpuBudget;
+        j["frame_budget_ms"] = FrameBudgetMs;
+
+        j["cells"] = json::array();
+        for(PartitionCell& cell : _cells){
+            json c;
+            c["x"] = cell.Coord.x;
+            c["z"] = cell.Coord.y;
+            c["path"] = cell.Path.generic_string();
+            c["cpu_bytes"] = cell.CpuBytes;
+            c["gpu_bytes"] = cell.GpuBytes;
+            j["cells"].push_back(c);
+        }
+
+        return j;
+    }
+
+    std::shared_ptr<WorldPartition> WorldPartition::FromJson(const json& data, std::filesystem::path directory){
+        if(!data.contains("cells") || !data["cells"].is_array()){
+            Print(PrintCode::ERROR, "WORLD_PARTITION", "Partition manifest must contain a cells array");
+            return nullptr;
+        }
+
+        std::shared_ptr<WorldPartition> result = std::make_shared<WorldPartition>();
+        result->_directory = directory;
+
+        result->CellSize = data["cell_size"];
+        if(data.contains("streaming_radius"))
+            result->StreamingRadius = data["streaming_radius"];
+        if(data.contains("eviction_margin"))
+            result->EvictionMargin = data["eviction_margin"];
+        if(data.contains("cpu_budget"))
+            result->CpuBudget = data["cpu_budget"];
+        if(data.contains("gpu_budget"))
+            result->GpuBudget = data["gpu_budget"];
+        if(data.contains("frame_budget_ms"))
+            result->FrameBudgetMs = data["frame_budget_ms"];
+
+        result->_cells.resize(data["cells"].size());
+        for(int i = 0; i < data["cells"].size(); i++){
+            const json& c = data["cells"][i];
+            PartitionCell& cell = result->_cells[i];
+
+            cell.Coord = glm::ivec2(c["x"].get<int>(), c["z"].get<int>());
+            cell.Path = c["path"].get<std::string>();
+            if(c.contains("cpu_bytes"))
+                cell.CpuBytes = c["cpu_bytes"];
+            if(c.contains("gpu_bytes"))
+                cell.GpuBytes = c["gpu_bytes"];
+        }
+
+        return result;
+    }
+
+    std::shared_ptr<WorldPartition> WorldPartition::ImportFromFile(std::filesystem::path filePath){
+        std::ifstream f(filePath);
+        if(!f){
+            Print(PrintCode::ERROR, "WORLD_PARTITION", "Invalid file path to import: " + filePath.string());
+            return nullptr;
+        }
+
+        json j = json::parse(f, nullptr, false);
+        if(j.is_discarded()){
+            Print(PrintCode::ERROR, "WORLD_PARTITION", "Failed to parse partition manifest at: " + filePath.string());
+            return nullptr;
+        }
+
+        return FromJson(j, filePath.parent_path());
+    }
+
+    bool WorldPartition::Export(const std::shared_ptr<Scene>& scene, std::filesystem::path directory, float cellSize, bool binary){
+        if(!scene || cellSize <= 0.0f){
+            Print(PrintCode::ERROR, "WORLD_PARTITION", "A scene and a positive cell size are required to partition.");
+            return false;
+        }
+
+        std::filesystem::create_directories(directory);
+
+        std::map<std::pair<int, int>, json> cellObjects;
+        std::map<std::pair<int, int>, size_t> cellGpuBytes;
+        for(std::shared_ptr<SceneObject>& o : scene->GetObjects()){
+            glm::vec3 position = o->GetWorldPosition();
+            std::pair<int, int> coord((int)std::floor(position.x / cellSize), (int)std::floor(position.z / cellSize));
+
+            json& objects = cellObjects[coord]["objects"];
+            if(objects.is_null()) objects = json::array();
+            objects.push_back(o->ToJson());
+            cellGpuBytes[coord] += estimateGpuBytes(o);
+        }
+
+        WorldPartition manifest;
+        manifest.CellSize = cellSize;
+
+        bool success = true;
+        manifest._cells.resize(cellObjects.size());
+        int i = 0;
+        for(auto& [coord, data] : cellObjects){
+            PartitionCell& cell = manifest._cells[i++];
+            cell.Coord = glm::ivec2(coord.first, coord.second);
+            cell.Path = "cell_" + std::to_string(coord.first) + "_" + std::to_string(coord.second) + (binary ? SceneBinary::EXTENSION : ".json");
+            cell.GpuBytes = cellGpuBytes[coord];
+
+            std::filesystem::path path = directory / cell.Path;
+            if(binary){
+                success &= SceneBinary::Write(path, std::move(data));
+            } else {
+                std::ofstream out(path);
+                out << data;
+                success &= (bool)out;
+            }
+
+            if(std::filesystem::exists(path))
+                cell.CpuBytes = std::filesystem::file_size(path);
+        }
+
+        std::ofstream out(directory / "partition.json");
+        out << std::setw(2) << manifest.ToJson() << std::endl;
+        success &= (bool)out;
+
+        if(!success) Print(PrintCode::ERROR, "WORLD_PARTITION", "Failed to write partition to " + directory.string());
+
+        return success;
+    }
+
+}